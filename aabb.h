@@ -0,0 +1,58 @@
+#ifndef AABB_H
+#define AABB_H
+#include <cfloat>
+#include <glm/glm.hpp>
+
+class AABB {
+  public:
+    // empty box, overlaps nothing
+    AABB() {
+      lower_ = glm::vec3(FLT_MAX);
+      upper_ = glm::vec3(-FLT_MAX);
+    }
+    AABB(glm::vec3 const & lower, glm::vec3 const & upper) {
+      lower_ = lower;
+      upper_ = upper;
+    }
+
+    glm::vec3 const & lower() const { return lower_; }
+    glm::vec3 const & upper() const { return upper_; }
+
+    void setBounds(glm::vec3 const & lower, glm::vec3 const & upper) {
+      lower_ = lower;
+      upper_ = upper;
+    }
+
+    bool overlaps(AABB const & other) const {
+      return lower_.x <= other.upper_.x && other.lower_.x <= upper_.x
+             && lower_.y <= other.upper_.y && other.lower_.y <= upper_.y
+             && lower_.z <= other.upper_.z && other.lower_.z <= upper_.z;
+    }
+
+    bool contains(AABB const & other) const {
+      return lower_.x <= other.lower_.x && other.upper_.x <= upper_.x
+             && lower_.y <= other.lower_.y && other.upper_.y <= upper_.y
+             && lower_.z <= other.lower_.z && other.upper_.z <= upper_.z;
+    }
+
+    glm::vec3 center() const { return (lower_ + upper_) * 0.5f; }
+
+    float surfaceArea() const {
+      glm::vec3 d = upper_ - lower_;
+      return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    static AABB merge(AABB const & a, AABB const & b) {
+      return AABB(glm::min(a.lower_, b.lower_), glm::max(a.upper_, b.upper_));
+    }
+
+    static AABB fatten(AABB const & box, float margin) {
+      return AABB(box.lower_ - glm::vec3(margin), box.upper_ + glm::vec3(margin));
+    }
+
+  private:
+    glm::vec3 lower_;
+    glm::vec3 upper_;
+};
+
+#endif
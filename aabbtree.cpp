@@ -0,0 +1,279 @@
+#include "aabbtree.h"
+#include <algorithm>
+#include <vector>
+#include "aabb.h"
+
+AABBTree::AABBTree() {
+  root_ = -1;
+  free_list_ = -1;
+  margin_ = 0.1f;
+}
+
+AABBTree::AABBTree(float margin) {
+  root_ = -1;
+  free_list_ = -1;
+  margin_ = margin;
+}
+
+void AABBTree::update(int object_id, AABB const & box) {
+  if ((int)leaves_.size() <= object_id) {
+    leaves_.resize(object_id + 1, -1);
+  }
+
+  int leaf = leaves_[object_id];
+  if (leaf != -1) {
+    if (nodes_[leaf].box.contains(box)) {
+      return;
+    }
+    removeLeaf(leaf);
+  } else {
+    leaf = allocateNode();
+    nodes_[leaf].object = object_id;
+    leaves_[object_id] = leaf;
+  }
+
+  nodes_[leaf].box = AABB::fatten(box, margin_);
+  insertLeaf(leaf);
+}
+
+void AABBTree::remove(int object_id) {
+  if ((int)leaves_.size() <= object_id || leaves_[object_id] == -1) {
+    return;
+  }
+  removeLeaf(leaves_[object_id]);
+  freeNode(leaves_[object_id]);
+  leaves_[object_id] = -1;
+}
+
+void AABBTree::query(int object_id, std::vector<int> & candidates) {
+  if ((int)leaves_.size() <= object_id || leaves_[object_id] == -1) {
+    return;
+  }
+  int leaf = leaves_[object_id];
+  AABB box = nodes_[leaf].box;
+
+  stack_.clear();
+  stack_.push_back(root_);
+  while (!stack_.empty()) {
+    int node = stack_.back();
+    stack_.pop_back();
+
+    Node const & n = nodes_[node];
+    if (!n.box.overlaps(box)) {
+      continue;
+    }
+    if (n.height == 0) {
+      if (node != leaf) {
+        candidates.push_back(n.object);
+      }
+    } else {
+      stack_.push_back(n.left);
+      stack_.push_back(n.right);
+    }
+  }
+}
+
+int AABBTree::allocateNode() {
+  int node;
+  if (free_list_ != -1) {
+    node = free_list_;
+    free_list_ = nodes_[node].parent;
+  } else {
+    node = nodes_.size();
+    nodes_.push_back(Node());
+  }
+
+  nodes_[node].parent = -1;
+  nodes_[node].left = -1;
+  nodes_[node].right = -1;
+  nodes_[node].height = 0;
+  nodes_[node].object = -1;
+  return node;
+}
+
+void AABBTree::freeNode(int node) {
+  nodes_[node].parent = free_list_;
+  nodes_[node].height = -1;
+  free_list_ = node;
+}
+
+void AABBTree::insertLeaf(int leaf) {
+  if (root_ == -1) {
+    root_ = leaf;
+    nodes_[leaf].parent = -1;
+    return;
+  }
+
+  // walk down to the sibling that grows the total surface area the least
+  AABB leaf_box = nodes_[leaf].box;
+  int index = root_;
+  while (nodes_[index].height > 0) {
+    int left = nodes_[index].left;
+    int right = nodes_[index].right;
+
+    float area = nodes_[index].box.surfaceArea();
+    float combined = AABB::merge(nodes_[index].box, leaf_box).surfaceArea();
+    float cost = 2.0f * combined;
+    float inheritance = 2.0f * (combined - area);
+
+    float cost_left = AABB::merge(leaf_box, nodes_[left].box).surfaceArea() + inheritance;
+    if (nodes_[left].height > 0) {
+      cost_left -= nodes_[left].box.surfaceArea();
+    }
+    float cost_right = AABB::merge(leaf_box, nodes_[right].box).surfaceArea() + inheritance;
+    if (nodes_[right].height > 0) {
+      cost_right -= nodes_[right].box.surfaceArea();
+    }
+
+    if (cost < cost_left && cost < cost_right) {
+      break;
+    }
+    index = (cost_left < cost_right) ? left : right;
+  }
+
+  int sibling = index;
+  int old_parent = nodes_[sibling].parent;
+  int new_parent = allocateNode();
+  nodes_[new_parent].parent = old_parent;
+  nodes_[new_parent].box = AABB::merge(leaf_box, nodes_[sibling].box);
+  nodes_[new_parent].height = nodes_[sibling].height + 1;
+
+  if (old_parent != -1) {
+    if (nodes_[old_parent].left == sibling) {
+      nodes_[old_parent].left = new_parent;
+    } else {
+      nodes_[old_parent].right = new_parent;
+    }
+  } else {
+    root_ = new_parent;
+  }
+  nodes_[new_parent].left = sibling;
+  nodes_[new_parent].right = leaf;
+  nodes_[sibling].parent = new_parent;
+  nodes_[leaf].parent = new_parent;
+
+  refitAncestors(new_parent);
+}
+
+void AABBTree::removeLeaf(int leaf) {
+  if (leaf == root_) {
+    root_ = -1;
+    return;
+  }
+
+  int parent = nodes_[leaf].parent;
+  int grandparent = nodes_[parent].parent;
+  int sibling = (nodes_[parent].left == leaf) ? nodes_[parent].right : nodes_[parent].left;
+
+  if (grandparent != -1) {
+    if (nodes_[grandparent].left == parent) {
+      nodes_[grandparent].left = sibling;
+    } else {
+      nodes_[grandparent].right = sibling;
+    }
+    nodes_[sibling].parent = grandparent;
+    freeNode(parent);
+    refitAncestors(grandparent);
+  } else {
+    root_ = sibling;
+    nodes_[sibling].parent = -1;
+    freeNode(parent);
+  }
+}
+
+void AABBTree::refitAncestors(int node) {
+  while (node != -1) {
+    node = balance(node);
+
+    int left = nodes_[node].left;
+    int right = nodes_[node].right;
+    nodes_[node].height = 1 + std::max(nodes_[left].height, nodes_[right].height);
+    nodes_[node].box = AABB::merge(nodes_[left].box, nodes_[right].box);
+
+    node = nodes_[node].parent;
+  }
+}
+
+// Rotates the taller grandchild of a up if a is out of balance and returns
+// the node that now sits where a was.
+int AABBTree::balance(int a) {
+  if (nodes_[a].height < 2) {
+    return a;
+  }
+
+  int b = nodes_[a].left;
+  int c = nodes_[a].right;
+  int skew = nodes_[c].height - nodes_[b].height;
+
+  if (skew > 1) {
+    int f = nodes_[c].left;
+    int g = nodes_[c].right;
+
+    nodes_[c].left = a;
+    nodes_[c].parent = nodes_[a].parent;
+    nodes_[a].parent = c;
+    if (nodes_[c].parent != -1) {
+      if (nodes_[nodes_[c].parent].left == a) {
+        nodes_[nodes_[c].parent].left = c;
+      } else {
+        nodes_[nodes_[c].parent].right = c;
+      }
+    } else {
+      root_ = c;
+    }
+
+    if (nodes_[f].height > nodes_[g].height) {
+      nodes_[c].right = f;
+      nodes_[a].right = g;
+      nodes_[g].parent = a;
+    } else {
+      nodes_[c].right = g;
+      nodes_[a].right = f;
+      nodes_[f].parent = a;
+      std::swap(f, g);
+    }
+    // g now hangs off a and f off c
+    nodes_[a].box = AABB::merge(nodes_[b].box, nodes_[g].box);
+    nodes_[a].height = 1 + std::max(nodes_[b].height, nodes_[g].height);
+    nodes_[c].box = AABB::merge(nodes_[a].box, nodes_[f].box);
+    nodes_[c].height = 1 + std::max(nodes_[a].height, nodes_[f].height);
+    return c;
+  }
+
+  if (skew < -1) {
+    int d = nodes_[b].left;
+    int e = nodes_[b].right;
+
+    nodes_[b].left = a;
+    nodes_[b].parent = nodes_[a].parent;
+    nodes_[a].parent = b;
+    if (nodes_[b].parent != -1) {
+      if (nodes_[nodes_[b].parent].left == a) {
+        nodes_[nodes_[b].parent].left = b;
+      } else {
+        nodes_[nodes_[b].parent].right = b;
+      }
+    } else {
+      root_ = b;
+    }
+
+    if (nodes_[d].height > nodes_[e].height) {
+      nodes_[b].right = d;
+      nodes_[a].left = e;
+      nodes_[e].parent = a;
+    } else {
+      nodes_[b].right = e;
+      nodes_[a].left = d;
+      nodes_[d].parent = a;
+      std::swap(d, e);
+    }
+    // e now hangs off a and d off b
+    nodes_[a].box = AABB::merge(nodes_[c].box, nodes_[e].box);
+    nodes_[a].height = 1 + std::max(nodes_[c].height, nodes_[e].height);
+    nodes_[b].box = AABB::merge(nodes_[a].box, nodes_[d].box);
+    nodes_[b].height = 1 + std::max(nodes_[a].height, nodes_[d].height);
+    return b;
+  }
+
+  return a;
+}
@@ -0,0 +1,43 @@
+#ifndef AABBTREE_H
+#define AABBTREE_H
+#include <vector>
+#include "aabb.h"
+#include "broadphase.h"
+
+// Dynamic bounding volume tree with one leaf per object. Leaves store a
+// fattened box, so an object only has to be reinserted once it leaves it.
+class AABBTree : public BroadPhase {
+  public:
+    AABBTree();
+    AABBTree(float margin);
+
+    virtual void update(int object_id, AABB const & box);
+    virtual void remove(int object_id);
+    virtual void query(int object_id, std::vector<int> & candidates);
+
+  private:
+    struct Node {
+      AABB box;
+      int parent;
+      int left;
+      int right;
+      int height;  // 0 for leaves, -1 for free nodes
+      int object;
+    };
+
+    int allocateNode();
+    void freeNode(int node);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    void refitAncestors(int node);
+    int balance(int node);
+
+    std::vector<Node> nodes_;
+    std::vector<int> leaves_;  // node of each object, -1 if not inserted
+    std::vector<int> stack_;
+    int root_;
+    int free_list_;
+    float margin_;
+};
+
+#endif
@@ -0,0 +1,50 @@
+#include "arena.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#define ARENA_BLOCK 65536  // bytes
+
+using namespace std;
+
+Arena::Arena() {
+  block_ = -1;
+  offset_ = 0;
+}
+
+void * Arena::allocate(size_t size, size_t alignment) {
+  while (true) {
+    if (block_ >= 0) {
+      size_t start = (offset_ + alignment - 1) / alignment * alignment;
+      if (start + size <= sizes_[block_]) {
+        offset_ = start + size;
+        return blocks_[block_].get() + start;
+      }
+    }
+
+    // on to the next block, or a new one in its place if it is too small
+    block_++;
+    offset_ = 0;
+    if (block_ == blocks_.size() || sizes_[block_] < size + alignment) {
+      size_t block_size = max((size_t)ARENA_BLOCK, size + alignment);
+      blocks_.insert(blocks_.begin() + block_, unique_ptr<char[]>(new char[block_size]));
+      sizes_.insert(sizes_.begin() + block_, block_size);
+    }
+  }
+}
+
+Arena::Mark Arena::mark() const {
+  Mark mark = { block_, offset_ };
+  return mark;
+}
+
+void Arena::rewind(Mark const & mark) {
+  block_ = mark.block;
+  offset_ = mark.offset;
+}
+
+Arena & Arena::local() {
+  static thread_local Arena arena;
+  return arena;
+}
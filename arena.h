@@ -0,0 +1,85 @@
+#ifndef ARENA_H
+#define ARENA_H
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Scratch memory handed out by bumping an offset through blocks that are
+// kept once allocated. Nothing is freed on its own, rewinding to a mark
+// frees everything allocated since at once.
+class Arena {
+  public:
+    struct Mark {
+      int block;
+      size_t offset;
+    };
+
+    Arena();
+
+    void * allocate(size_t size, size_t alignment);
+    Mark mark() const;
+    void rewind(Mark const & mark);
+
+    // one per thread, for scratch space of code that runs on any of them
+    static Arena & local();
+
+  private:
+    Arena(Arena const &);
+    Arena & operator=(Arena const &);
+
+    std::vector<std::unique_ptr<char[]> > blocks_;
+    std::vector<size_t> sizes_;
+    int block_;  // being allocated from, -1 before the first allocation
+    size_t offset_;
+};
+
+// Rewinds the arena to where it was when the scope started.
+class ArenaScope {
+  public:
+    ArenaScope(Arena & arena) : arena_(arena), mark_(arena.mark()) { }
+    ~ArenaScope() {
+      arena_.rewind(mark_);
+    }
+
+  private:
+    Arena & arena_;
+    Arena::Mark mark_;
+};
+
+// For containers that live within an ArenaScope. Memory a container
+// gives back stays used until the scope ends, so reserve what they need
+// up front rather than letting them grow.
+template <typename T>
+class ArenaAllocator {
+  public:
+    typedef T value_type;
+
+    ArenaAllocator(Arena * arena) : arena_(arena) { }
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const & other) : arena_(other.arena()) { }
+
+    T * allocate(size_t n) {
+      return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *, size_t) { }
+
+    Arena * arena() const {
+      return arena_;
+    }
+
+  private:
+    Arena * arena_;
+};
+
+template <typename T, typename U>
+bool operator==(ArenaAllocator<T> const & a, ArenaAllocator<U> const & b) {
+  return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(ArenaAllocator<T> const & a, ArenaAllocator<U> const & b) {
+  return a.arena() != b.arena();
+}
+
+#endif
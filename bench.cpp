@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <glm/glm.hpp>
+#include "collision.h"
+#include "collisionevent.h"
+#include "cuboid.h"
+#include "motionengine.h"
+#include "object.h"
+#include "posebatch.h"
+
+#define WARMUP_SAMPLES 20
+#define SAMPLES 200
+#define BATCH_OBJECTS 100000
+
+using namespace std;
+
+// Keeps the compiler from optimizing away the work being timed.
+static volatile float sink;
+
+// Runs fn batch times per sample and reports the time per call over the
+// samples. fn gets the index of the call so inputs can vary between calls.
+template <typename F>
+static void measure(char const * name, char const * filter, int batch, F fn) {
+  if (filter != NULL && strstr(name, filter) == NULL) {
+    return;
+  }
+
+  vector<double> samples;
+  int call = 0;
+  for (int s = 0; s < WARMUP_SAMPLES + SAMPLES; s++) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < batch; i++) {
+      fn(call++);
+    }
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+    if (s >= WARMUP_SAMPLES) {
+      samples.push_back(elapsed.count() / batch);
+    }
+  }
+
+  sort(samples.begin(), samples.end());
+  double median = samples[samples.size() / 2];
+  double p99 = samples[(samples.size() * 99) / 100];
+  printf("%-28s %12.1f %12.1f %12.0f\n", name, median, p99, 1e9 / median);
+}
+
+int main(int argc, char * argv[]) {
+  char const * filter = (argc > 1) ? argv[1] : NULL;
+
+  Cuboid s_cube = Cuboid(1.0, 1.0, 1.0, 10.0);
+  Cuboid l_cube = Cuboid(2.0, 2.0, 2.0, 10.0);
+  vector<Object*> objects;
+  objects.push_back(&s_cube);
+  objects.push_back(&l_cube);
+
+  CollisionEvent s_event = CollisionEvent(0,                            // object id
+                                          0.0,                          // time
+                                          glm::vec3(-1.0f, -1.0f, 0.0f),// initial_coordinates
+                                          glm::angleAxis(1.0f, glm::vec3(0.0f, 0.0f, 1.0f)),  // initial_orientation
+                                          glm::vec3(0.0f, 1.0f, 0.0f),  // axis_of_rotation
+                                          glm::vec3(1.0f, 1.0f, 0.0f),  // velocity
+                                          1.0f);                        // angular_velocity
+
+  CollisionEvent l_event = CollisionEvent(1,                            // object id
+                                          0.0,                          // time
+                                          glm::vec3(-1.0f, 1.0f, 0.0f), // initial_coordinates
+                                          glm::angleAxis(1.0f, glm::normalize(glm::vec3(0.0f, 1.0f, 1.0f))),  // initial_orientation
+                                          glm::normalize(glm::vec3(1.0f, 0.0f, 1.0f)),  // axis_of_rotation
+                                          glm::vec3(1.0f, -1.0f, 0.0f), // velocity
+                                          1.0f);                        // angular_velocity
+
+  // a spread of directions, so nothing is answered from a single cache line
+  vector<glm::vec3> directions;
+  for (int i = 0; i < 64; i++) {
+    float theta = 0.1f * i;
+    float phi = 0.37f * i;
+    directions.push_back(glm::vec3(cos(theta) * sin(phi), sin(theta) * sin(phi), cos(phi)));
+  }
+
+  printf("%-28s %12s %12s %12s\n", "kernel", "median ns/op", "p99 ns/op", "ops/s");
+
+  MotionEngine motionengine;
+  measure("MotionEngine::pose", filter, 1000, [&](int call) {
+    glm::mat4 pose;
+    motionengine.pose(s_event, 0.001f * (call & 1023), pose);
+    sink = pose[3][0];
+  });
+
+  // every object at once, one call covers BATCH_OBJECTS poses
+  PoseBatch posebatch;
+  posebatch.resize(BATCH_OBJECTS);
+  for (int i = 0; i < BATCH_OBJECTS; i++) {
+    CollisionEvent event = s_event;
+    event.setObjectId(i);
+    event.setInitialCoordinates(directions[i & 63] * (float)i);
+    event.setAxisOfRotation(directions[(i + 7) & 63]);
+    posebatch.set(event);
+  }
+  vector<glm::mat4> poses(BATCH_OBJECTS);
+  measure("PoseBatch::evaluate 100k", filter, 1, [&](int call) {
+    posebatch.evaluate(0.001f * (call & 1023), &poses[0]);
+    sink = poses[call % BATCH_OBJECTS][3][0];
+  });
+
+  Collision collision = Collision(objects);
+  measure("generateCollisionEvents", filter, 1000, [&](int call) {
+    CollisionEvent final_a, final_b;
+    glm::vec3 point = glm::vec3(-0.5f, 0.0f, 0.0f) + 0.1f * directions[call & 63];
+    collision.generateCollisionEvents(0.5f, point, 0, 1, s_event, l_event, final_a, final_b);
+    sink = final_a.velocity()->x;
+  });
+
+  measure("Cuboid::inertia", filter, 1000, [&](int call) {
+    sink = l_cube.inertia(directions[call & 63]);
+  });
+
+  measure("Cuboid::normalToEdge", filter, 1000, [&](int call) {
+    glm::vec3 normal;
+    l_cube.normalToEdge(directions[call & 63], normal);
+    sink = normal.x;
+  });
+
+  measure("Cuboid construction", filter, 1, [&](int call) {
+    Cuboid cuboid = Cuboid(1.0f + 0.001f * (call & 15), 2.0, 3.0, 10.0);
+    sink = cuboid.inertia(directions[0]);
+  });
+
+  return 0;
+}
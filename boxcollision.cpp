@@ -0,0 +1,234 @@
+#include "boxcollision.h"
+#include <cfloat>
+#include <cmath>
+#include <glm/glm.hpp>
+#include "contact.h"
+#include "cuboid.h"
+#define EPSILON 1e-5f
+#define EDGE_BIAS 0.95f  // prefer face axes unless an edge axis is clearly shallower
+
+BoxCollision::BoxCollision() { }
+
+bool BoxCollision::intersect(Cuboid const & a,
+                             glm::mat4 const & pose_a,
+                             Cuboid const & b,
+                             glm::mat4 const & pose_b,
+                             Contact & contact) const {
+  return intersect(a, pose_a, b, pose_b, 0.0f, contact);
+}
+
+bool BoxCollision::intersect(Cuboid const & a,
+                             glm::mat4 const & pose_a,
+                             Cuboid const & b,
+                             glm::mat4 const & pose_b,
+                             float margin,
+                             Contact & contact) const {
+  glm::vec3 center_a = glm::vec3(pose_a[3]);
+  glm::vec3 center_b = glm::vec3(pose_b[3]);
+  glm::vec3 axes_a[3], axes_b[3];
+  for (int i = 0; i < 3; i++) {
+    axes_a[i] = glm::normalize(glm::vec3(pose_a[i]));
+    axes_b[i] = glm::normalize(glm::vec3(pose_b[i]));
+  }
+  glm::vec3 extents_a = a.halfExtents() + glm::vec3(margin * 0.5f);
+  glm::vec3 extents_b = b.halfExtents() + glm::vec3(margin * 0.5f);
+
+  // everything below is expressed in a's frame
+  float rot[3][3], abs_rot[3][3];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      rot[i][j] = glm::dot(axes_a[i], axes_b[j]);
+      abs_rot[i][j] = fabs(rot[i][j]) + EPSILON;
+    }
+  }
+  glm::vec3 d = center_b - center_a;
+  glm::vec3 t = glm::vec3(glm::dot(d, axes_a[0]), glm::dot(d, axes_a[1]), glm::dot(d, axes_a[2]));
+
+  float best_depth = FLT_MAX;
+  int best_axis = -1;
+  glm::vec3 best_normal;  // from a towards b
+
+  for (int i = 0; i < 3; i++) {
+    float ra = extents_a[i];
+    float rb = extents_b[0] * abs_rot[i][0] + extents_b[1] * abs_rot[i][1] + extents_b[2] * abs_rot[i][2];
+    float depth = ra + rb - fabs(t[i]);
+    if (depth < 0.0f) {
+      return false;
+    }
+    if (depth < best_depth) {
+      best_depth = depth;
+      best_axis = i;
+      best_normal = (t[i] < 0.0f) ? -axes_a[i] : axes_a[i];
+    }
+  }
+
+  for (int j = 0; j < 3; j++) {
+    float ra = extents_a[0] * abs_rot[0][j] + extents_a[1] * abs_rot[1][j] + extents_a[2] * abs_rot[2][j];
+    float rb = extents_b[j];
+    float tj = glm::dot(d, axes_b[j]);
+    float depth = ra + rb - fabs(tj);
+    if (depth < 0.0f) {
+      return false;
+    }
+    if (depth < best_depth) {
+      best_depth = depth;
+      best_axis = 3 + j;
+      best_normal = (tj < 0.0f) ? -axes_b[j] : axes_b[j];
+    }
+  }
+
+  for (int i = 0; i < 3; i++) {
+    int i1 = (i + 1) % 3;
+    int i2 = (i + 2) % 3;
+    for (int j = 0; j < 3; j++) {
+      int j1 = (j + 1) % 3;
+      int j2 = (j + 2) % 3;
+
+      glm::vec3 axis = glm::cross(axes_a[i], axes_b[j]);
+      float length = glm::length(axis);
+      if (length < EPSILON) {
+        // parallel edges, already covered by the face axes
+        continue;
+      }
+
+      float ra = extents_a[i1] * abs_rot[i2][j] + extents_a[i2] * abs_rot[i1][j];
+      float rb = extents_b[j1] * abs_rot[i][j2] + extents_b[j2] * abs_rot[i][j1];
+      float tl = t[i2] * rot[i1][j] - t[i1] * rot[i2][j];
+      float depth = (ra + rb - fabs(tl)) / length;
+      if (depth < 0.0f) {
+        return false;
+      }
+      if (depth < EDGE_BIAS * best_depth) {
+        best_depth = depth;
+        best_axis = 6 + 3 * i + j;
+        best_normal = (glm::dot(axis, d) < 0.0f) ? -axis / length : axis / length;
+      }
+    }
+  }
+
+  contact.clearPoints();
+  contact.setNormal(-best_normal);
+  contact.setDepth(best_depth);
+
+  if (best_axis < 3) {
+    faceContact(center_a, axes_a, extents_a, best_axis, best_normal,
+                center_b, axes_b, extents_b, contact);
+  } else if (best_axis < 6) {
+    faceContact(center_b, axes_b, extents_b, best_axis - 3, -best_normal,
+                center_a, axes_a, extents_a, contact);
+  } else {
+    edgeContact(center_a, axes_a, extents_a, (best_axis - 6) / 3,
+                center_b, axes_b, extents_b, (best_axis - 6) % 3,
+                best_normal, contact);
+  }
+
+  if (contact.numPoints() == 0) {
+    contact.addPoint((center_a + center_b) * 0.5f);
+  }
+  return true;
+}
+
+// Clips the face of the incident box that faces the reference box against
+// the sides of the reference face, keeping the points that are inside.
+void BoxCollision::faceContact(glm::vec3 const & center_ref,
+                               glm::vec3 const * axes_ref,
+                               glm::vec3 const & extents_ref,
+                               int face,
+                               glm::vec3 const & normal,
+                               glm::vec3 const & center_inc,
+                               glm::vec3 const * axes_inc,
+                               glm::vec3 const & extents_inc,
+                               Contact & contact) const {
+  int k = 0;
+  for (int i = 1; i < 3; i++) {
+    if (fabs(glm::dot(axes_inc[i], normal)) > fabs(glm::dot(axes_inc[k], normal))) {
+      k = i;
+    }
+  }
+  glm::vec3 inc_normal = (glm::dot(axes_inc[k], normal) > 0.0f) ? -axes_inc[k] : axes_inc[k];
+  glm::vec3 inc_center = center_inc + inc_normal * extents_inc[k];
+  glm::vec3 u = axes_inc[(k + 1) % 3] * extents_inc[(k + 1) % 3];
+  glm::vec3 v = axes_inc[(k + 2) % 3] * extents_inc[(k + 2) % 3];
+
+  glm::vec3 polygon[8], clipped[8];
+  int count = 4;
+  polygon[0] = inc_center + u + v;
+  polygon[1] = inc_center + u - v;
+  polygon[2] = inc_center - u - v;
+  polygon[3] = inc_center - u + v;
+
+  for (int side = 1; side < 3; side++) {
+    int axis = (face + side) % 3;
+    for (int sign = -1; sign <= 1; sign += 2) {
+      glm::vec3 plane_normal = axes_ref[axis] * (float)sign;
+      float offset = glm::dot(center_ref, plane_normal) + extents_ref[axis];
+
+      int clipped_count = 0;
+      for (int i = 0; i < count; i++) {
+        glm::vec3 const & p = polygon[i];
+        glm::vec3 const & q = polygon[(i + 1) % count];
+        float dp = glm::dot(p, plane_normal) - offset;
+        float dq = glm::dot(q, plane_normal) - offset;
+        if (dp <= 0.0f) {
+          clipped[clipped_count++] = p;
+        }
+        if ((dp < 0.0f && dq > 0.0f) || (dp > 0.0f && dq < 0.0f)) {
+          clipped[clipped_count++] = p + (q - p) * (dp / (dp - dq));
+        }
+      }
+
+      count = clipped_count;
+      for (int i = 0; i < count; i++) {
+        polygon[i] = clipped[i];
+      }
+    }
+  }
+
+  glm::vec3 ref_center = center_ref + normal * extents_ref[face];
+  for (int i = 0; i < count; i++) {
+    float separation = glm::dot(polygon[i] - ref_center, normal);
+    if (separation <= 0.0f) {
+      // halfway between the two surfaces
+      contact.addPoint(polygon[i] - normal * (separation * 0.5f));
+    }
+  }
+}
+
+// Closest points between the two edges that touch along the separating axis.
+void BoxCollision::edgeContact(glm::vec3 const & center_a,
+                               glm::vec3 const * axes_a,
+                               glm::vec3 const & extents_a,
+                               int edge_a,
+                               glm::vec3 const & center_b,
+                               glm::vec3 const * axes_b,
+                               glm::vec3 const & extents_b,
+                               int edge_b,
+                               glm::vec3 const & normal,
+                               Contact & contact) const {
+  glm::vec3 point_a = center_a;
+  glm::vec3 point_b = center_b;
+  for (int k = 0; k < 3; k++) {
+    if (k != edge_a) {
+      float sign = (glm::dot(axes_a[k], normal) > 0.0f) ? 1.0f : -1.0f;
+      point_a += axes_a[k] * extents_a[k] * sign;
+    }
+    if (k != edge_b) {
+      float sign = (glm::dot(axes_b[k], normal) > 0.0f) ? -1.0f : 1.0f;
+      point_b += axes_b[k] * extents_b[k] * sign;
+    }
+  }
+
+  glm::vec3 const & dir_a = axes_a[edge_a];
+  glm::vec3 const & dir_b = axes_b[edge_b];
+  glm::vec3 r = point_a - point_b;
+  float cosine = glm::dot(dir_a, dir_b);
+  float c = glm::dot(dir_a, r);
+  float f = glm::dot(dir_b, r);
+  float denominator = 1.0f - cosine * cosine;
+
+  float s = (denominator > EPSILON) ? (cosine * f - c) / denominator : 0.0f;
+  s = glm::clamp(s, -extents_a[edge_a], extents_a[edge_a]);
+  float t = glm::clamp(cosine * s + f, -extents_b[edge_b], extents_b[edge_b]);
+
+  contact.addPoint((point_a + dir_a * s + point_b + dir_b * t) * 0.5f);
+}
@@ -0,0 +1,51 @@
+#ifndef BOXCOLLISION_H
+#define BOXCOLLISION_H
+#include <glm/glm.hpp>
+#include "contact.h"
+#include "cuboid.h"
+
+// Separating axis test between two oriented cuboids. Tests the 3 + 3 face
+// normals and the 9 edge cross products and stops at the first axis that
+// separates them.
+class BoxCollision {
+  public:
+    BoxCollision();
+
+    bool intersect(Cuboid const & a,
+                   glm::mat4 const & pose_a,
+                   Cuboid const & b,
+                   glm::mat4 const & pose_b,
+                   Contact & contact) const;
+
+    // boxes closer than margin also count as touching
+    bool intersect(Cuboid const & a,
+                   glm::mat4 const & pose_a,
+                   Cuboid const & b,
+                   glm::mat4 const & pose_b,
+                   float margin,
+                   Contact & contact) const;
+
+  private:
+    void faceContact(glm::vec3 const & center_ref,
+                     glm::vec3 const * axes_ref,
+                     glm::vec3 const & extents_ref,
+                     int face,
+                     glm::vec3 const & normal,
+                     glm::vec3 const & center_inc,
+                     glm::vec3 const * axes_inc,
+                     glm::vec3 const & extents_inc,
+                     Contact & contact) const;
+
+    void edgeContact(glm::vec3 const & center_a,
+                     glm::vec3 const * axes_a,
+                     glm::vec3 const & extents_a,
+                     int edge_a,
+                     glm::vec3 const & center_b,
+                     glm::vec3 const * axes_b,
+                     glm::vec3 const & extents_b,
+                     int edge_b,
+                     glm::vec3 const & normal,
+                     Contact & contact) const;
+};
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+#include <vector>
+#include "aabb.h"
+
+enum BroadPhaseType {
+  SWEEP_AND_PRUNE,
+  AABB_TREE,
+  SPATIAL_HASH
+};
+
+class BroadPhase {
+  public:
+    virtual ~BroadPhase() { }
+
+    virtual void update(int object_id, AABB const & box) = 0;
+    // until the next update
+    virtual void remove(int object_id) = 0;
+    virtual void query(int object_id, std::vector<int> & candidates) = 0;
+};
+
+#endif
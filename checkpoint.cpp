@@ -0,0 +1,164 @@
+#include "checkpoint.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "collisionevent.h"
+
+#define CHECKPOINT_MAGIC "CDCHKPT"
+#define CHECKPOINT_VERSION 1
+#define BLOCK_ALIGNMENT 8
+
+static_assert(sizeof(CheckpointHeader) == 32, "checkpoint header layout");
+
+static size_t padding(size_t size) {
+  return (BLOCK_ALIGNMENT - size % BLOCK_ALIGNMENT) % BLOCK_ALIGNMENT;
+}
+
+CheckpointWriter::CheckpointWriter() {
+  file_ = NULL;
+  failed_ = false;
+}
+
+CheckpointWriter::~CheckpointWriter() {
+  if (file_ != NULL) {
+    // never completed, so keep the previous checkpoint
+    fclose(file_);
+    remove((path_ + ".tmp").c_str());
+  }
+}
+
+bool CheckpointWriter::open(char const * path, int num_objects, float time) {
+  path_ = path;
+  std::string temporary = path_ + ".tmp";
+  file_ = fopen(temporary.c_str(), "wb");
+  if (file_ == NULL) {
+    perror(temporary.c_str());
+    return false;
+  }
+  failed_ = false;
+
+  CheckpointHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+  header.version = CHECKPOINT_VERSION;
+  header.event_size = sizeof(CollisionEvent);
+  header.num_objects = num_objects;
+  header.time = time;
+  failed_ = fwrite(&header, sizeof(header), 1, file_) != 1;
+  return !failed_;
+}
+
+void CheckpointWriter::write(void const * data, size_t size) {
+  static const char zeros[BLOCK_ALIGNMENT] = { 0 };
+  uint64_t block_size = size;
+  if (failed_ ||
+      fwrite(&block_size, sizeof(block_size), 1, file_) != 1 ||
+      (size > 0 && fwrite(data, size, 1, file_) != 1) ||
+      fwrite(zeros, 1, padding(size), file_) != padding(size)) {
+    failed_ = true;
+  }
+}
+
+bool CheckpointWriter::close() {
+  if (file_ == NULL) {
+    return false;
+  }
+  std::string temporary = path_ + ".tmp";
+  // on disk before it replaces the previous one
+  bool ok = !failed_ && fflush(file_) == 0 && fsync(fileno(file_)) == 0;
+  ok = (fclose(file_) == 0) && ok;
+  file_ = NULL;
+  if (!ok || rename(temporary.c_str(), path_.c_str()) != 0) {
+    perror(path_.c_str());
+    remove(temporary.c_str());
+    return false;
+  }
+  return true;
+}
+
+CheckpointReader::CheckpointReader() {
+  mapping_ = NULL;
+  mapping_size_ = 0;
+  offset_ = 0;
+}
+
+CheckpointReader::~CheckpointReader() {
+  close();
+}
+
+bool CheckpointReader::open(char const * path) {
+  close();
+
+  int fd = ::open(path, O_RDONLY);
+  if (fd == -1) {
+    perror(path);
+    return false;
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0 || status.st_size < (off_t)sizeof(CheckpointHeader)) {
+    fprintf(stderr, "%s: not a checkpoint\n", path);
+    ::close(fd);
+    return false;
+  }
+  void * mapping = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    perror(path);
+    return false;
+  }
+  mapping_ = mapping;
+  mapping_size_ = status.st_size;
+  offset_ = sizeof(CheckpointHeader);
+
+  CheckpointHeader const * header = (CheckpointHeader const *)mapping_;
+  if (strncmp(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic)) != 0 ||
+      header->version != CHECKPOINT_VERSION ||
+      header->event_size != sizeof(CollisionEvent)) {
+    fprintf(stderr, "%s: not a checkpoint this build can read\n", path);
+    close();
+    return false;
+  }
+  return true;
+}
+
+void CheckpointReader::close() {
+  if (mapping_ != NULL) {
+    munmap(mapping_, mapping_size_);
+  }
+  mapping_ = NULL;
+  mapping_size_ = 0;
+  offset_ = 0;
+}
+
+int CheckpointReader::numObjects() const {
+  return ((CheckpointHeader const *)mapping_)->num_objects;
+}
+
+float CheckpointReader::time() const {
+  return ((CheckpointHeader const *)mapping_)->time;
+}
+
+void const * CheckpointReader::read(size_t & size) {
+  uint64_t block_size;
+  if (mapping_ == NULL || mapping_size_ - offset_ < sizeof(block_size)) {
+    return NULL;
+  }
+  char const * bytes = (char const *)mapping_;
+  memcpy(&block_size, bytes + offset_, sizeof(block_size));
+  size_t start = offset_ + sizeof(block_size);
+  if (block_size > mapping_size_ - start) {
+    return NULL;
+  }
+  size = block_size;
+  offset_ = start + size + padding(size);
+  if (offset_ > mapping_size_) {
+    offset_ = mapping_size_;
+  }
+  return bytes + start;
+}
@@ -0,0 +1,61 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// A checkpoint is a header followed by blocks, each a 64 bit size and that
+// many bytes, padded to a multiple of 8. The blocks are the engine's arrays
+// exactly as they are in memory, so restoring maps the file and copies them
+// back whole rather than parsing anything. That ties a checkpoint to the
+// build that wrote it, which is why the header has the size of an event
+// and every block size is checked on the way in.
+struct CheckpointHeader {
+  char magic[8];  // "CDCHKPT" and a 0
+  uint32_t version;
+  uint32_t event_size;  // sizeof(CollisionEvent) in the build that wrote it
+  uint32_t num_objects;
+  float time;  // of the latest applied event
+  uint32_t reserved[2];
+};
+
+// Goes to path.tmp first and is renamed over path once complete, so a
+// crash while writing leaves the previous checkpoint in place.
+class CheckpointWriter {
+  public:
+    CheckpointWriter();
+    ~CheckpointWriter();
+
+    bool open(char const * path, int num_objects, float time);
+    void write(void const * data, size_t size);
+    bool close();
+
+  private:
+    FILE * file_;
+    std::string path_;
+    bool failed_;
+};
+
+class CheckpointReader {
+  public:
+    CheckpointReader();
+    ~CheckpointReader();
+
+    bool open(char const * path);
+    void close();
+
+    int numObjects() const;
+    float time() const;
+
+    // The next block, pointing into the mapping until close, or NULL if
+    // there is none.
+    void const * read(size_t & size);
+
+  private:
+    void * mapping_;
+    size_t mapping_size_;
+    size_t offset_;
+};
+
+#endif
@@ -1,13 +1,12 @@
 #include "collision.h"
 #include <cstdio>
-#include <glm/gtx/matrix_interpolation.hpp>
 #include <glm/gtx/norm.hpp>
-#include <glm/gtx/transform.hpp>
-#include <glm/gtx/vector_angle.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <glm/glm.hpp>
 #include <vector>
 #include "collisionevent.h"
 #include "object.h"
+#include "profiler.h"
 #define ELASTICITY 1.0
 
 Collision::Collision() { }
@@ -24,17 +23,50 @@ void Collision::generateCollisionEvents(float time,
                                         CollisionEvent const & initial_collision_b,
                                         CollisionEvent & final_collision_a,
                                         CollisionEvent & final_collision_b) const {
+  float dtime_b = time - initial_collision_b.time();
+  glm::vec3 coordinates_b;
+  coordinatesAtTime(dtime_b, initial_collision_b, coordinates_b);
+
+  glm::vec3 normal;
+  normalToEdge(point - coordinates_b, dtime_b, object_b, initial_collision_b, normal);
+
+  generateCollisionEvents(time,
+                          point,
+                          normal,
+                          object_a,
+                          object_b,
+                          initial_collision_a,
+                          initial_collision_b,
+                          final_collision_a,
+                          final_collision_b);
+}
+
+// The normal points from object b towards object a.
+void Collision::generateCollisionEvents(float time,
+                                        glm::vec3 const & point,
+                                        glm::vec3 const & normal,
+                                        int object_a,
+                                        int object_b,
+                                        CollisionEvent const & initial_collision_a,
+                                        CollisionEvent const & initial_collision_b,
+                                        CollisionEvent & final_collision_a,
+                                        CollisionEvent & final_collision_b) const {
+  PROFILE_SCOPE(PHASE_COLLISION_RESPONSE);
   float dtime_a = time - initial_collision_a.time();
   float mass_a = object(object_a)->mass();
   glm::vec3 radius_a;
   radiusAtPoint(dtime_a, point, initial_collision_a, radius_a);
-  float moment_of_inertia_a = momentOfInertia(object_a, *initial_collision_a.axis_of_rotation());
+  glm::quat orientation_a;
+  orientationAtTime(dtime_a, initial_collision_a, orientation_a);
+  float moment_of_inertia_a = momentOfInertia(object_a, orientation_a, *initial_collision_a.axis_of_rotation());
 
-  float dtime_b = time - initial_collision_a.time();
+  float dtime_b = time - initial_collision_b.time();
   float mass_b = object(object_b)->mass();
   glm::vec3 radius_b;
   radiusAtPoint(dtime_b, point, initial_collision_b, radius_b);
-  float moment_of_inertia_b = momentOfInertia(object_b, *initial_collision_b.axis_of_rotation());
+  glm::quat orientation_b;
+  orientationAtTime(dtime_b, initial_collision_b, orientation_b);
+  float moment_of_inertia_b = momentOfInertia(object_b, orientation_b, *initial_collision_b.axis_of_rotation());
 
   glm::vec3 velocity_a;
   velocityAtPoint(dtime_a, point, initial_collision_a, velocity_a);
@@ -54,22 +86,8 @@ void Collision::generateCollisionEvents(float time,
   coordinatesAtTime(dtime_b, initial_collision_b, coordinates_b);
   final_collision_b.setInitialCoordinates(coordinates_b);
 
-  axisAngle(dtime_a,
-            initial_collision_a.initial_angle(),
-            *initial_collision_a.initial_axis(),
-            initial_collision_a.angular_velocity(),
-            *initial_collision_a.axis_of_rotation(),
-            final_collision_a);
-
-  axisAngle(dtime_b,
-            initial_collision_b.initial_angle(),
-            *initial_collision_b.initial_axis(),
-            initial_collision_b.angular_velocity(),
-            *initial_collision_b.axis_of_rotation(),
-            final_collision_b);
-
-  glm::vec3 normal;
-  normalToEdge(point - coordinates_b, dtime_b, object_b, initial_collision_b, normal);
+  final_collision_a.setInitialOrientation(orientation_a);
+  final_collision_b.setInitialOrientation(orientation_b);
 
   float impulse_parameter = impulseParameter(ELASTICITY,
                                              impact_velocity,
@@ -93,13 +111,13 @@ void Collision::generateCollisionEvents(float time,
                  initial_collision_a,
                  final_collision_a);
 
-  angularVelocity(impulse_parameter,
+  angularVelocity(-impulse_parameter,
                   normal,
                   radius_b,
                   moment_of_inertia_b,
                   initial_collision_b,
                   final_collision_b);
-  linearVelocity(impulse_parameter,
+  linearVelocity(-impulse_parameter,
                  normal,
                  mass_b,
                  initial_collision_b,
@@ -110,24 +128,6 @@ Object const * Collision::object(int object_id) const {
   return (*objects_)[object_id];
 }
 
-void Collision::axisAngle(float dtime,
-                          float initial_angle,
-                          glm::vec3 const & initial_axis,
-                          float angular_velocity,
-                          glm::vec3 const & axis_of_rotation,
-                          CollisionEvent & final_collision) const {
-  glm::mat4 irot = glm::rotate(initial_angle, initial_axis);
-  glm::mat4 trot = glm::rotate(dtime * angular_velocity, axis_of_rotation);
-  glm::mat4 rot = trot * irot;
-
-  float final_angle;
-  glm::vec3 final_axis;
-  glm::axisAngle(rot, final_axis, final_angle);
-
-  final_collision.setInitialAxis(final_axis);
-  final_collision.setInitialAngle(final_angle);
-}
-
 void Collision::linearVelocity(float impulse_parameter,
                                glm::vec3 const & normal,
                                float mass,
@@ -148,8 +148,14 @@ void Collision::angularVelocity(float impulse_parameter,
   glm::vec3 final_omega = initial_omega
                           + glm::cross(radius, impulse_parameter * normal) / moment_of_inertia;
 
-  final_collision.setAxisOfRotation(glm::normalize(final_omega));
-  final_collision.setAngularVelocity(glm::length(final_omega));
+  float speed = glm::length(final_omega);
+  if (speed > 0.0f) {
+    final_collision.setAxisOfRotation(final_omega / speed);
+  } else {
+    // no spin, so any unit axis will do
+    final_collision.setAxisOfRotation(*initial_collision.axis_of_rotation());
+  }
+  final_collision.setAngularVelocity(speed);
 }
 
 void Collision::normalToEdge(glm::vec3 const & relative_point,
@@ -157,15 +163,14 @@ void Collision::normalToEdge(glm::vec3 const & relative_point,
                              int object_id,
                              CollisionEvent const & collision,
                              glm::vec3 & normal) const {
-  glm::vec3 canonical_point = glm::rotate(
-                                glm::rotate(relative_point,
-                                            collision.initial_angle(),
-                                            *collision.initial_axis()
-                                ),
-                                dtime * collision.angular_velocity(),
-                                *collision.axis_of_rotation()
-                              );
-  object(object_id)->normalToEdge(canonical_point, normal);
+  // undo the rotation to get the point in the object's own frame, then
+  // bring the normal back out
+  glm::quat orientation;
+  orientationAtTime(dtime, collision, orientation);
+  glm::vec3 canonical_point = glm::conjugate(orientation) * relative_point;
+  glm::vec3 canonical_normal;
+  object(object_id)->normalToEdge(canonical_point, canonical_normal);
+  normal = orientation * canonical_normal;
 }
 
 void Collision::coordinatesAtTime(float dtime,
@@ -174,6 +179,13 @@ void Collision::coordinatesAtTime(float dtime,
   coordinates = *collision.initial_coordinates() + dtime * *collision.velocity();
 }
   
+void Collision::orientationAtTime(float dtime,
+                                  CollisionEvent const & collision,
+                                  glm::quat & orientation) const {
+  glm::quat spin = glm::angleAxis(dtime * collision.angular_velocity(), *collision.axis_of_rotation());
+  orientation = glm::normalize(spin * *collision.initial_orientation());
+}
+
 void Collision::velocityAtPoint(float dtime,
                                 glm::vec3 const & point,
                                 CollisionEvent const & collision,
@@ -193,8 +205,12 @@ void Collision::radiusAtPoint(float dtime,
   radius = point - coordinates;
 }
 
-float Collision::momentOfInertia(int object_id, glm::vec3 const & axis) const {
-  return (*objects_)[object_id]->inertia(axis);
+// The inertia tensor is in the object's own frame, so bring the world axis
+// into it first.
+float Collision::momentOfInertia(int object_id,
+                                 glm::quat const & orientation,
+                                 glm::vec3 const & axis) const {
+  return (*objects_)[object_id]->inertia(glm::conjugate(orientation) * axis);
 }
 
 float Collision::impulseParameter(float elasticity,
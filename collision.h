@@ -1,6 +1,7 @@
 #ifndef COLLISION_H
 #define COLLISION_H
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <vector>
 #include "collisionevent.h"
 #include "object.h"
@@ -19,6 +20,16 @@ class Collision {
                                  CollisionEvent & final_collision_a,
                                  CollisionEvent & final_collision_b) const;
 
+    void generateCollisionEvents(float time,
+                                 glm::vec3 const & point,
+                                 glm::vec3 const & normal,
+                                 int object_a,
+                                 int object_b,
+                                 CollisionEvent const & initial_collision_a,
+                                 CollisionEvent const & initial_collision_b,
+                                 CollisionEvent & final_collision_a,
+                                 CollisionEvent & final_collision_b) const;
+
   private:
     Object const * object(int object_id) const;
 
@@ -35,13 +46,6 @@ class Collision {
                          CollisionEvent const & initial_collision,
                          CollisionEvent & final_collision) const;
 
-    void axisAngle(float dtime,
-                          float initial_angle,
-                          glm::vec3 const & initial_axis,
-                          float angular_velocity,
-                          glm::vec3 const & axis_of_rotation,
-                          CollisionEvent & final_collision) const;
-
     void normalToEdge(glm::vec3 const & relative_point,
                       float dtime,
                       int object_id,
@@ -58,8 +62,13 @@ class Collision {
                        glm::vec3 & radius) const;
 
     float momentOfInertia(int object_id,
+                          glm::quat const & orientation,
                           glm::vec3 const & axis) const;
 
+    void orientationAtTime(float dtime,
+                           CollisionEvent const & collision,
+                           glm::quat & orientation) const;
+
     void velocityAtPoint(float dtime,
                          glm::vec3 const & point,
                          CollisionEvent const & collision,
@@ -1,9 +1,5 @@
-#ifdef __APPLE__
-#include <GLUT/glut.h>
-#else
-#include <GL/glut.h>
-#endif
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include "collisionevent.h"
 
 CollisionEvent::CollisionEvent() { }
@@ -11,16 +7,14 @@ CollisionEvent::CollisionEvent() { }
 CollisionEvent::CollisionEvent(int object,
                                float time,
                                glm::vec3 initial_coordinates,
-                               glm::vec3 initial_axis,
-                               float initial_angle,
+                               glm::quat initial_orientation,
                                glm::vec3 axis_of_rotation,
                                glm::vec3 velocity,
                                float angular_velocity) {
   object_ = object;
   time_ = time;
   initial_coordinates_ = initial_coordinates;
-  initial_axis_ = initial_axis;
-  initial_angle_ = initial_angle;
+  initial_orientation_ = initial_orientation;
 
   axis_of_rotation_ = axis_of_rotation;
   velocity_ = velocity;
@@ -30,16 +24,14 @@ CollisionEvent::CollisionEvent(int object,
 void CollisionEvent::setValues(int object,
                                float time,
                                glm::vec3 initial_coordinates,
-                               glm::vec3 initial_axis,
-                               float initial_angle,
+                               glm::quat initial_orientation,
                                glm::vec3 axis_of_rotation,
                                glm::vec3 velocity,
                                float angular_velocity) {
   object_ = object;
   time_ = time;
   initial_coordinates_ = initial_coordinates;
-  initial_axis_ = initial_axis;
-  initial_angle_ = initial_angle;
+  initial_orientation_ = initial_orientation;
 
   axis_of_rotation_ = axis_of_rotation;
   velocity_ = velocity;
@@ -58,12 +50,8 @@ glm::vec3 const * CollisionEvent::initial_coordinates() const {
   return &initial_coordinates_;
 }
 
-glm::vec3 const * CollisionEvent::initial_axis() const {
-  return &initial_axis_;
-}
-
-float CollisionEvent::initial_angle() const {
-  return initial_angle_;
+glm::quat const * CollisionEvent::initial_orientation() const {
+  return &initial_orientation_;
 }
 
 glm::vec3 const * CollisionEvent::axis_of_rotation() const {
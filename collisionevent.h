@@ -1,6 +1,7 @@
 #ifndef COLLISIONEVENT_H
 #define COLLISIONEVENT_H
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 class CollisionEvent {
   public:
@@ -8,8 +9,7 @@ class CollisionEvent {
     CollisionEvent(int object,
                    float time,
                    glm::vec3 initial_coordinates,
-                   glm::vec3 initial_axis,
-                   float initial_angle,
+                   glm::quat initial_orientation,
                    glm::vec3 axis_of_rotation,
                    glm::vec3 velocity,
                    float angular_velocity);
@@ -17,17 +17,15 @@ class CollisionEvent {
     void setObjectId(int object) { object_ = object; };
     void setTime(float time) { time_ = time; };
     void setInitialCoordinates(glm::vec3 initial_coordinates) { initial_coordinates_ = initial_coordinates; };
-    void setInitialAxis(glm::vec3 initial_axis) { initial_axis_ = initial_axis; };
-    void setInitialAngle(int initial_angle) { initial_angle_ = initial_angle; };
+    void setInitialOrientation(glm::quat initial_orientation) { initial_orientation_ = initial_orientation; };
     void setAxisOfRotation(glm::vec3 axis_of_rotation) { axis_of_rotation_ = axis_of_rotation; };
     void setVelocity(glm::vec3 velocity) { velocity_ = velocity; };
-    void setAngularVelocity(int angular_velocity) { angular_velocity_ = angular_velocity; };
+    void setAngularVelocity(float angular_velocity) { angular_velocity_ = angular_velocity; };
 
     void setValues(int object,
                    float time,
                    glm::vec3 initial_coordinates,
-                   glm::vec3 initial_axis,
-                   float initial_angle,
+                   glm::quat initial_orientation,
                    glm::vec3 axis_of_rotation,
                    glm::vec3 velocity,
                    float angular_velocity);
@@ -35,8 +33,7 @@ class CollisionEvent {
     int object() const;
     float time() const;
     glm::vec3 const * initial_coordinates() const;
-    glm::vec3 const * initial_axis() const;
-    float initial_angle() const;
+    glm::quat const * initial_orientation() const;  // unit quaternion
 
     glm::vec3 const * velocity() const;
     glm::vec3 const * axis_of_rotation() const;
@@ -46,11 +43,10 @@ class CollisionEvent {
     int object_;  // TODO: Use an entity id instead.
     float time_;
     glm::vec3 initial_coordinates_;
-    glm::vec3 initial_axis_;
-    float initial_angle_;
+    glm::quat initial_orientation_;
 
     glm::vec3 velocity_;
-    glm::vec3 axis_of_rotation_;
+    glm::vec3 axis_of_rotation_;  // unit vector
     float angular_velocity_;
 };
 
@@ -0,0 +1,45 @@
+#ifndef CONTACT_H
+#define CONTACT_H
+#include <glm/glm.hpp>
+
+// Result of a narrow phase test. The normal points from the second object
+// towards the first, which is what Collision expects.
+class Contact {
+  public:
+    Contact() {
+      depth_ = 0.0f;
+      num_points_ = 0;
+    }
+
+    glm::vec3 const & normal() const { return normal_; }
+    float depth() const { return depth_; }
+    int numPoints() const { return num_points_; }
+    glm::vec3 const & point(int i) const { return points_[i]; }
+
+    glm::vec3 center() const {
+      glm::vec3 sum = glm::vec3(0.0f);
+      for (int i = 0; i < num_points_; i++) {
+        sum += points_[i];
+      }
+      return sum / (float)num_points_;
+    }
+
+    void setNormal(glm::vec3 const & normal) { normal_ = normal; }
+    void setDepth(float depth) { depth_ = depth; }
+    void clearPoints() { num_points_ = 0; }
+    void addPoint(glm::vec3 const & point) {
+      if (num_points_ < MAX_POINTS) {
+        points_[num_points_++] = point;
+      }
+    }
+
+  private:
+    const static int MAX_POINTS = 8;
+
+    glm::vec3 normal_;
+    float depth_;
+    glm::vec3 points_[MAX_POINTS];
+    int num_points_;
+};
+
+#endif
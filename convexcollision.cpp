@@ -0,0 +1,462 @@
+#include "convexcollision.h"
+#include <cfloat>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include "arena.h"
+#include "contact.h"
+#include "supportmapping.h"
+#define MAX_ITERATIONS 64
+#define GJK_TOLERANCE 1e-6f
+#define EPA_TOLERANCE 1e-4f
+
+ConvexCollision::ConvexCollision() { }
+
+bool ConvexCollision::intersect(SupportMapping const & a,
+                                glm::mat4 const & pose_a,
+                                SupportMapping const & b,
+                                glm::mat4 const & pose_b,
+                                Contact & contact) const {
+  Shapes shapes;
+  shapes.a = &a;
+  shapes.b = &b;
+  shapes.pose_a = &pose_a;
+  shapes.pose_b = &pose_b;
+  shapes.rotation_a = glm::transpose(glm::mat3(pose_a));
+  shapes.rotation_b = glm::transpose(glm::mat3(pose_b));
+  shapes.start_a = 0;
+  shapes.start_b = 0;
+
+  Vertex simplex[4];
+  int count;
+  glm::vec3 closest;
+  contact.clearPoints();
+  if (!gjk(shapes, simplex, count, closest)) {
+    return false;
+  }
+
+  if (completeSimplex(shapes, simplex, count)) {
+    epa(shapes, simplex, contact);
+  } else {
+    // the difference is flat, so the objects only touch
+    glm::vec3 point_a, point_b;
+    witnessPoints(simplex, count, point_a, point_b);
+    glm::vec3 direction = glm::vec3(pose_a[3]) - glm::vec3(pose_b[3]);
+    float length = glm::length(direction);
+    contact.setNormal(length > 0.0f ? direction / length : glm::vec3(0.0f, 1.0f, 0.0f));
+    contact.setDepth(0.0f);
+    contact.addPoint((point_a + point_b) * 0.5f);
+  }
+  return true;
+}
+
+float ConvexCollision::distance(SupportMapping const & a,
+                                glm::mat4 const & pose_a,
+                                SupportMapping const & b,
+                                glm::mat4 const & pose_b,
+                                glm::vec3 & point_a,
+                                glm::vec3 & point_b) const {
+  Shapes shapes;
+  shapes.a = &a;
+  shapes.b = &b;
+  shapes.pose_a = &pose_a;
+  shapes.pose_b = &pose_b;
+  shapes.rotation_a = glm::transpose(glm::mat3(pose_a));
+  shapes.rotation_b = glm::transpose(glm::mat3(pose_b));
+  shapes.start_a = 0;
+  shapes.start_b = 0;
+
+  Vertex simplex[4];
+  int count;
+  glm::vec3 closest;
+  bool intersecting = gjk(shapes, simplex, count, closest);
+
+  witnessPoints(simplex, count < 4 ? count : 1, point_a, point_b);
+  return intersecting ? 0.0f : glm::length(closest);
+}
+
+void ConvexCollision::support(Shapes const & shapes, glm::vec3 const & direction, Vertex & vertex) const {
+  glm::vec3 local_a = shapes.a->support(shapes.rotation_a * direction, shapes.start_a);
+  glm::vec3 local_b = shapes.b->support(shapes.rotation_b * -direction, shapes.start_b);
+  vertex.a = glm::vec3(*shapes.pose_a * glm::vec4(local_a, 1.0f));
+  vertex.b = glm::vec3(*shapes.pose_b * glm::vec4(local_b, 1.0f));
+  vertex.w = vertex.a - vertex.b;
+}
+
+// Returns true if the origin is inside the difference a - b. Otherwise
+// closest is the point of the difference nearest to the origin and the
+// simplex is the smallest one that contains it.
+bool ConvexCollision::gjk(Shapes const & shapes, Vertex * simplex, int & count, glm::vec3 & closest) const {
+  glm::vec3 direction = glm::vec3((*shapes.pose_b)[3]) - glm::vec3((*shapes.pose_a)[3]);
+  if (glm::dot(direction, direction) < GJK_TOLERANCE) {
+    direction = glm::vec3(1.0f, 0.0f, 0.0f);
+  }
+  support(shapes, direction, simplex[0]);
+  count = 1;
+  closest = simplex[0].w;
+
+  for (int iteration = 0; iteration < MAX_ITERATIONS; iteration++) {
+    float distance2 = glm::dot(closest, closest);
+    if (distance2 < GJK_TOLERANCE * GJK_TOLERANCE) {
+      return true;
+    }
+
+    Vertex vertex;
+    support(shapes, -closest, vertex);
+    if (distance2 - glm::dot(closest, vertex.w) <= GJK_TOLERANCE * distance2) {
+      return false;
+    }
+    for (int i = 0; i < count; i++) {
+      if (glm::dot(vertex.w - simplex[i].w, vertex.w - simplex[i].w) < GJK_TOLERANCE) {
+        return false;
+      }
+    }
+
+    simplex[count++] = vertex;
+    closestOnSimplex(simplex, count, closest);
+    if (count == 4) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ConvexCollision::closestOnSimplex(Vertex * simplex, int & count, glm::vec3 & closest) const {
+  if (count == 2) {
+    closestOnSegment(simplex, count, closest);
+    return;
+  }
+  if (count == 3) {
+    closestOnTriangle(simplex, count, closest);
+    return;
+  }
+
+  // tetrahedron, check every face the origin is in front of
+  static const int faces[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+  float best = FLT_MAX;
+  Vertex best_simplex[3];
+  int best_count = 0;
+  for (int f = 0; f < 4; f++) {
+    glm::vec3 const & a = simplex[faces[f][0]].w;
+    glm::vec3 normal = glm::cross(simplex[faces[f][1]].w - a, simplex[faces[f][2]].w - a);
+    float side_origin = glm::dot(-a, normal);
+    float side_opposite = glm::dot(simplex[faces[f][3]].w - a, normal);
+    if (side_origin * side_opposite > 0.0f) {
+      continue;
+    }
+
+    Vertex triangle[3] = { simplex[faces[f][0]], simplex[faces[f][1]], simplex[faces[f][2]] };
+    int triangle_count = 3;
+    glm::vec3 point;
+    closestOnTriangle(triangle, triangle_count, point);
+    if (glm::dot(point, point) < best) {
+      best = glm::dot(point, point);
+      closest = point;
+      best_count = triangle_count;
+      for (int i = 0; i < triangle_count; i++) {
+        best_simplex[i] = triangle[i];
+      }
+    }
+  }
+
+  if (best_count == 0) {
+    closest = glm::vec3(0.0f);
+    return;
+  }
+  count = best_count;
+  for (int i = 0; i < count; i++) {
+    simplex[i] = best_simplex[i];
+  }
+}
+
+// Closest point to the origin on a triangle, see Ericson's Real-Time
+// Collision Detection 5.1.5.
+void ConvexCollision::closestOnTriangle(Vertex * simplex, int & count, glm::vec3 & closest) const {
+  glm::vec3 a = simplex[0].w;
+  glm::vec3 b = simplex[1].w;
+  glm::vec3 c = simplex[2].w;
+  glm::vec3 ab = b - a;
+  glm::vec3 ac = c - a;
+
+  float d1 = glm::dot(ab, -a);
+  float d2 = glm::dot(ac, -a);
+  if (d1 <= 0.0f && d2 <= 0.0f) {
+    count = 1;
+    closest = a;
+    return;
+  }
+
+  float d3 = glm::dot(ab, -b);
+  float d4 = glm::dot(ac, -b);
+  if (d3 >= 0.0f && d4 <= d3) {
+    simplex[0] = simplex[1];
+    count = 1;
+    closest = b;
+    return;
+  }
+
+  float vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+    closest = a + ab * (d1 / (d1 - d3));
+    count = 2;
+    return;
+  }
+
+  float d5 = glm::dot(ab, -c);
+  float d6 = glm::dot(ac, -c);
+  if (d6 >= 0.0f && d5 <= d6) {
+    simplex[0] = simplex[2];
+    count = 1;
+    closest = c;
+    return;
+  }
+
+  float vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+    closest = a + ac * (d2 / (d2 - d6));
+    simplex[1] = simplex[2];
+    count = 2;
+    return;
+  }
+
+  float va = d3 * d6 - d5 * d4;
+  if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+    closest = b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    simplex[0] = simplex[1];
+    simplex[1] = simplex[2];
+    count = 2;
+    return;
+  }
+
+  float denominator = 1.0f / (va + vb + vc);
+  closest = a + ab * (vb * denominator) + ac * (vc * denominator);
+  count = 3;
+}
+
+void ConvexCollision::closestOnSegment(Vertex * simplex, int & count, glm::vec3 & closest) const {
+  glm::vec3 a = simplex[0].w;
+  glm::vec3 ab = simplex[1].w - a;
+  float t = glm::dot(-a, ab) / glm::dot(ab, ab);
+  if (t <= 0.0f) {
+    count = 1;
+    closest = a;
+  } else if (t >= 1.0f) {
+    simplex[0] = simplex[1];
+    count = 1;
+    closest = simplex[0].w;
+  } else {
+    closest = a + ab * t;
+  }
+}
+
+// Points on a and b that map to the closest point of the simplex.
+void ConvexCollision::witnessPoints(Vertex const * simplex,
+                                    int count,
+                                    glm::vec3 & point_a,
+                                    glm::vec3 & point_b) const {
+  if (count == 1) {
+    point_a = simplex[0].a;
+    point_b = simplex[0].b;
+  } else if (count == 2) {
+    glm::vec3 ab = simplex[1].w - simplex[0].w;
+    float length2 = glm::dot(ab, ab);
+    float t = (length2 > 0.0f) ? glm::clamp(glm::dot(-simplex[0].w, ab) / length2, 0.0f, 1.0f) : 0.0f;
+    point_a = simplex[0].a + (simplex[1].a - simplex[0].a) * t;
+    point_b = simplex[0].b + (simplex[1].b - simplex[0].b) * t;
+  } else {
+    glm::vec3 normal = glm::cross(simplex[1].w - simplex[0].w, simplex[2].w - simplex[0].w);
+    float area2 = glm::dot(normal, normal);
+    glm::vec3 p = normal * (glm::dot(simplex[0].w, normal) / area2);
+    float u = glm::dot(glm::cross(simplex[1].w - p, simplex[2].w - p), normal) / area2;
+    float v = glm::dot(glm::cross(simplex[2].w - p, simplex[0].w - p), normal) / area2;
+    float w = 1.0f - u - v;
+    point_a = simplex[0].a * u + simplex[1].a * v + simplex[2].a * w;
+    point_b = simplex[0].b * u + simplex[1].b * v + simplex[2].b * w;
+  }
+}
+
+// GJK can stop with fewer than four points when the objects only just
+// touch. EPA needs a tetrahedron, so grow the simplex into one.
+bool ConvexCollision::completeSimplex(Shapes const & shapes, Vertex * simplex, int & count) const {
+  static const glm::vec3 axes[6] = {
+    glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f),
+    glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+    glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f)
+  };
+
+  if (count == 1) {
+    for (int i = 0; i < 6 && count == 1; i++) {
+      support(shapes, axes[i], simplex[1]);
+      if (glm::length(simplex[1].w - simplex[0].w) > EPA_TOLERANCE) {
+        count = 2;
+      }
+    }
+  }
+
+  if (count == 2) {
+    glm::vec3 line = glm::normalize(simplex[1].w - simplex[0].w);
+    int least = 0;
+    for (int i = 1; i < 3; i++) {
+      if (fabs(line[i]) < fabs(line[least])) {
+        least = i;
+      }
+    }
+    glm::vec3 perpendicular = glm::normalize(glm::cross(line, axes[2 * least]));
+    glm::vec3 directions[4] = { perpendicular, -perpendicular,
+                                glm::cross(line, perpendicular), -glm::cross(line, perpendicular) };
+    for (int i = 0; i < 4 && count == 2; i++) {
+      support(shapes, directions[i], simplex[2]);
+      glm::vec3 offset = simplex[2].w - simplex[0].w;
+      if (glm::length(offset - line * glm::dot(offset, line)) > EPA_TOLERANCE) {
+        count = 3;
+      }
+    }
+  }
+
+  if (count == 3) {
+    glm::vec3 normal = glm::normalize(glm::cross(simplex[1].w - simplex[0].w, simplex[2].w - simplex[0].w));
+    for (int i = 0; i < 2 && count == 3; i++) {
+      support(shapes, (i == 0) ? normal : -normal, simplex[3]);
+      if (fabs(glm::dot(simplex[3].w - simplex[0].w, normal)) > EPA_TOLERANCE) {
+        count = 4;
+      }
+    }
+  }
+
+  return count == 4;
+}
+
+// Expands the polytope towards the face of a - b closest to the origin.
+// Its vertices, faces and outline live in the arena of the thread, which
+// the scope gives back at the end. The polytope is convex, so it never has
+// more than twice as many faces as vertices.
+void ConvexCollision::epa(Shapes const & shapes, Vertex const * simplex, Contact & contact) const {
+  Arena & arena = Arena::local();
+  ArenaScope scope(arena);
+  Vertices vertices = Vertices(ArenaAllocator<Vertex>(&arena));
+  vertices.reserve(4 + MAX_ITERATIONS);
+  vertices.assign(simplex, simplex + 4);
+  std::vector<Face, ArenaAllocator<Face> > faces = std::vector<Face, ArenaAllocator<Face> >(
+      ArenaAllocator<Face>(&arena));
+  faces.reserve(2 * (4 + MAX_ITERATIONS));
+  static const int tetrahedron[4][3] = { { 0, 1, 2 }, { 0, 3, 1 }, { 0, 2, 3 }, { 1, 3, 2 } };
+  for (int f = 0; f < 4; f++) {
+    Face face;
+    if (makeFace(vertices, tetrahedron[f][0], tetrahedron[f][1], tetrahedron[f][2], face)) {
+      faces.push_back(face);
+    }
+  }
+
+  std::vector<std::pair<int, int>, ArenaAllocator<std::pair<int, int> > > horizon =
+      std::vector<std::pair<int, int>, ArenaAllocator<std::pair<int, int> > >(
+          ArenaAllocator<std::pair<int, int> >(&arena));
+  horizon.reserve(3 * (4 + MAX_ITERATIONS));
+  int best = 0;
+  for (int iteration = 0; iteration < MAX_ITERATIONS && !faces.empty(); iteration++) {
+    best = 0;
+    for (int f = 1; f < (int)faces.size(); f++) {
+      if (faces[f].distance < faces[best].distance) {
+        best = f;
+      }
+    }
+
+    Vertex vertex;
+    support(shapes, faces[best].normal, vertex);
+    if (glm::dot(vertex.w, faces[best].normal) - faces[best].distance < EPA_TOLERANCE) {
+      break;
+    }
+    // a point the polytope already has means it can not grow any further
+    bool known = false;
+    for (int i = 0; i < (int)vertices.size() && !known; i++) {
+      known = glm::dot(vertex.w - vertices[i].w, vertex.w - vertices[i].w) < EPA_TOLERANCE * EPA_TOLERANCE;
+    }
+    if (known) {
+      break;
+    }
+
+    // remove every face the new point can see, keeping the outline of the hole
+    horizon.clear();
+    for (int f = 0; f < (int)faces.size(); ) {
+      if (glm::dot(faces[f].normal, vertex.w - vertices[faces[f].v[0]].w) <= 0.0f) {
+        f++;
+        continue;
+      }
+      for (int e = 0; e < 3; e++) {
+        std::pair<int, int> edge = std::make_pair(faces[f].v[e], faces[f].v[(e + 1) % 3]);
+        bool shared = false;
+        for (int h = 0; h < (int)horizon.size(); h++) {
+          if (horizon[h].first == edge.second && horizon[h].second == edge.first) {
+            horizon[h] = horizon.back();
+            horizon.pop_back();
+            shared = true;
+            break;
+          }
+        }
+        if (!shared) {
+          horizon.push_back(edge);
+        }
+      }
+      faces[f] = faces.back();
+      faces.pop_back();
+    }
+
+    vertices.push_back(vertex);
+    int v = vertices.size() - 1;
+    for (int h = 0; h < (int)horizon.size(); h++) {
+      Face face;
+      if (makeFace(vertices, horizon[h].first, horizon[h].second, v, face)) {
+        faces.push_back(face);
+      }
+    }
+    best = -1;
+  }
+
+  if (best == -1) {
+    best = 0;
+    for (int f = 1; f < (int)faces.size(); f++) {
+      if (faces[f].distance < faces[best].distance) {
+        best = f;
+      }
+    }
+  }
+  if (faces.empty()) {
+    contact.setNormal(glm::vec3(0.0f, 1.0f, 0.0f));
+    contact.setDepth(0.0f);
+    contact.addPoint((simplex[0].a + simplex[0].b) * 0.5f);
+    return;
+  }
+
+  Face const & face = faces[best];
+  Vertex triangle[3] = { vertices[face.v[0]], vertices[face.v[1]], vertices[face.v[2]] };
+  glm::vec3 point_a, point_b;
+  witnessPoints(triangle, 3, point_a, point_b);
+
+  // moving a against the face normal separates the objects
+  contact.setNormal(-face.normal);
+  contact.setDepth(face.distance);
+  contact.addPoint((point_a + point_b) * 0.5f);
+}
+
+// Faces point away from the origin, which is inside the polytope.
+bool ConvexCollision::makeFace(Vertices const & vertices, int a, int b, int c, Face & face) const {
+  glm::vec3 normal = glm::cross(vertices[b].w - vertices[a].w, vertices[c].w - vertices[a].w);
+  float length = glm::length(normal);
+  if (length < GJK_TOLERANCE) {
+    return false;
+  }
+  normal /= length;
+
+  float distance = glm::dot(normal, vertices[a].w);
+  if (distance < 0.0f) {
+    normal = -normal;
+    distance = -distance;
+    std::swap(b, c);
+  }
+  face.v[0] = a;
+  face.v[1] = b;
+  face.v[2] = c;
+  face.normal = normal;
+  face.distance = distance;
+  return true;
+}
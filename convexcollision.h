@@ -0,0 +1,73 @@
+#ifndef CONVEXCOLLISION_H
+#define CONVEXCOLLISION_H
+#include <vector>
+#include <glm/glm.hpp>
+#include "arena.h"
+#include "contact.h"
+#include "supportmapping.h"
+
+// GJK for the distance between two convex objects and EPA for the
+// penetration depth and normal once they intersect. Only needs the
+// support mapping of each object, so it works for any convex shape.
+class ConvexCollision {
+  public:
+    ConvexCollision();
+
+    bool intersect(SupportMapping const & a,
+                   glm::mat4 const & pose_a,
+                   SupportMapping const & b,
+                   glm::mat4 const & pose_b,
+                   Contact & contact) const;
+
+    // 0 if the objects intersect, otherwise point_a and point_b are the
+    // closest points on each
+    float distance(SupportMapping const & a,
+                   glm::mat4 const & pose_a,
+                   SupportMapping const & b,
+                   glm::mat4 const & pose_b,
+                   glm::vec3 & point_a,
+                   glm::vec3 & point_b) const;
+
+  private:
+    struct Vertex {
+      glm::vec3 w;  // a - b
+      glm::vec3 a;
+      glm::vec3 b;
+    };
+
+    typedef std::vector<Vertex, ArenaAllocator<Vertex> > Vertices;
+
+    struct Face {
+      int v[3];
+      glm::vec3 normal;
+      float distance;
+    };
+
+    struct Shapes {
+      SupportMapping const * a;
+      SupportMapping const * b;
+      glm::mat4 const * pose_a;
+      glm::mat4 const * pose_b;
+      glm::mat3 rotation_a;  // transposed, world to object frame
+      glm::mat3 rotation_b;
+      mutable int start_a;   // hill climbing hints
+      mutable int start_b;
+    };
+
+    void support(Shapes const & shapes, glm::vec3 const & direction, Vertex & vertex) const;
+
+    bool gjk(Shapes const & shapes, Vertex * simplex, int & count, glm::vec3 & closest) const;
+    void closestOnSimplex(Vertex * simplex, int & count, glm::vec3 & closest) const;
+    void closestOnTriangle(Vertex * simplex, int & count, glm::vec3 & closest) const;
+    void closestOnSegment(Vertex * simplex, int & count, glm::vec3 & closest) const;
+    void witnessPoints(Vertex const * simplex,
+                       int count,
+                       glm::vec3 & point_a,
+                       glm::vec3 & point_b) const;
+
+    bool completeSimplex(Shapes const & shapes, Vertex * simplex, int & count) const;
+    void epa(Shapes const & shapes, Vertex const * simplex, Contact & contact) const;
+    bool makeFace(Vertices const & vertices, int a, int b, int c, Face & face) const;
+};
+
+#endif
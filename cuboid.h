@@ -1,363 +1,29 @@
 #ifndef CUBOID_H
 #define CUBOID_H
-#define CUBES_PER_SIDE 10
 #include "object.h"
+#include "shape.h"
 #include <glm/glm.hpp>
 
 class Cuboid : public Object {
   public:
     Cuboid(float x, float y, float z, float mass);
+    Cuboid(Shape const & shape, float mass);
 
-    virtual const glm::vec4 * verts() const { return verts_; }
-    virtual const glm::highp_uvec3 * tris() const { return tris_; }
-    virtual int numverts() const { return NUM_VERTS; }
-    virtual int numtris() const { return NUM_TRIS; }
-    virtual int mass() const { return mass_; }
+    virtual const glm::vec4 * verts() const { return shape_->verts(); }
+    virtual const glm::highp_uvec3 * tris() const { return shape_->tris(); }
+    virtual int numverts() const { return shape_->numverts(); }
+    virtual int numtris() const { return shape_->numtris(); }
+    virtual float mass() const { return mass_; }
     virtual float inertia(glm::vec3 const & axis) const;
+    virtual void inertiaTensor(glm::mat3 & tensor) const;
     virtual void normalToEdge(glm::vec3 const & point, glm::vec3 & normal) const;
+    virtual Shape const * shape() const { return shape_; }
 
-  private:
-    const static int NUM_VERTS = 8;
-    const static int NUM_TRIS = 12;
+    glm::vec3 const & halfExtents() const { return shape_->halfExtents(); }
 
+  private:
+    Shape const * shape_;
     float mass_;
-
-    void genverts(float x, float y, float z);
-    void genchunks(float x, float y, float z);
-    void gensphere();
-    float inertia_at_axis(glm::vec3 const & axis);
-
-    glm::vec4 verts_[NUM_VERTS];
-    glm::highp_uvec3 tris_[NUM_TRIS] = {
-      { 0, 3, 1 },  { 0, 2, 3 },  { 4, 2, 0 },  { 4, 6, 2 },
-      { 5, 6, 4 },  { 5, 7, 6 },  { 1, 7, 5 },  { 1, 3, 7 },
-      { 0, 5, 4 },  { 0, 1, 5 },  { 2, 3, 7 },  { 2, 6, 7 }
-    };
-    glm::vec3 chunks_[CUBES_PER_SIDE * CUBES_PER_SIDE * CUBES_PER_SIDE];
-    float sphere_[642];
-    glm::vec3 sphere_verts_[642] = { 
-      {  0.52573,  0.00000,  0.85065 }, {  0.52573,  0.00000, -0.85065 },
-      { -0.52573,  0.00000, -0.85065 }, { -0.52573,  0.00000,  0.85065 },
-      {  0.85065,  0.52573,  0.00000 }, { -0.85065,  0.52573,  0.00000 },
-      { -0.85065, -0.52573,  0.00000 }, {  0.85065, -0.52573,  0.00000 },
-      {  0.00000,  0.85065,  0.52573 }, {  0.00000, -0.85065,  0.52573 },
-      {  0.00000, -0.85065, -0.52573 }, {  0.00000,  0.85065, -0.52573 },
-      {  0.30902, -0.50000,  0.80902 }, {  0.00000,  0.00000,  1.00000 },
-      { -0.30902, -0.50000,  0.80902 }, { -0.80902, -0.30902,  0.50000 },
-      { -0.50000, -0.80902,  0.30902 }, { -0.50000, -0.80902, -0.30902 },
-      {  0.00000, -1.00000,  0.00000 }, {  0.50000, -0.80902, -0.30902 },
-      {  0.50000, -0.80902,  0.30902 }, {  0.80902, -0.30902,  0.50000 },
-      {  0.80902,  0.30902,  0.50000 }, {  0.50000,  0.80902,  0.30902 },
-      {  0.30902,  0.50000,  0.80902 }, { -0.30902,  0.50000,  0.80902 },
-      { -0.50000,  0.80902,  0.30902 }, { -0.80902,  0.30902,  0.50000 },
-      { -1.00000,  0.00000,  0.00000 }, { -0.80902,  0.30902, -0.50000 },
-      { -0.80902, -0.30902, -0.50000 }, { -0.30902, -0.50000, -0.80902 },
-      {  0.00000,  0.00000, -1.00000 }, {  0.30902, -0.50000, -0.80902 },
-      {  0.80902, -0.30902, -0.50000 }, {  0.80902,  0.30902, -0.50000 },
-      {  1.00000,  0.00000,  0.00000 }, {  0.50000,  0.80902, -0.30902 },
-      {  0.00000,  1.00000,  0.00000 }, { -0.50000,  0.80902, -0.30902 },
-      { -0.30902,  0.50000, -0.80902 }, {  0.30902,  0.50000, -0.80902 },
-      {  0.16062, -0.70205,  0.69378 }, {  0.00000, -0.52573,  0.85065 },
-      { -0.16062, -0.70205,  0.69378 }, {  0.27327,  0.00000,  0.96194 },
-      {  0.16246, -0.26287,  0.95106 }, {  0.43389, -0.25989,  0.86267 },
-      { -0.43389, -0.25989,  0.86267 }, { -0.16246, -0.26287,  0.95106 },
-      { -0.27327,  0.00000,  0.96194 }, { -0.42533, -0.68819,  0.58779 },
-      { -0.25989, -0.86267,  0.43389 }, { -0.69378, -0.16062,  0.70205 },
-      { -0.58779, -0.42533,  0.68819 }, { -0.70205, -0.69378,  0.16062 },
-      { -0.68819, -0.58779,  0.42533 }, { -0.86267, -0.43389,  0.25989 },
-      { -0.26287, -0.95106,  0.16246 }, {  0.00000, -0.96194,  0.27327 },
-      { -0.70205, -0.69378, -0.16062 }, { -0.52573, -0.85065,  0.00000 },
-      {  0.00000, -0.96194, -0.27327 }, { -0.26287, -0.95106, -0.16246 },
-      { -0.25989, -0.86267, -0.43389 }, {  0.26287, -0.95106,  0.16246 },
-      {  0.25989, -0.86267,  0.43389 }, {  0.25989, -0.86267, -0.43389 },
-      {  0.26287, -0.95106, -0.16246 }, {  0.70205, -0.69378,  0.16062 },
-      {  0.52573, -0.85065,  0.00000 }, {  0.70205, -0.69378, -0.16062 },
-      {  0.42533, -0.68819,  0.58779 }, {  0.86267, -0.43389,  0.25989 },
-      {  0.68819, -0.58779,  0.42533 }, {  0.58779, -0.42533,  0.68819 },
-      {  0.69378, -0.16062,  0.70205 }, {  0.69378,  0.16062,  0.70205 },
-      {  0.58779,  0.42533,  0.68819 }, {  0.43389,  0.25989,  0.86267 },
-      {  0.70205,  0.69378,  0.16062 }, {  0.68819,  0.58779,  0.42533 },
-      {  0.86267,  0.43389,  0.25989 }, {  0.16062,  0.70205,  0.69378 },
-      {  0.42533,  0.68819,  0.58779 }, {  0.25989,  0.86267,  0.43389 },
-      {  0.16246,  0.26287,  0.95106 }, { -0.16062,  0.70205,  0.69378 },
-      {  0.00000,  0.52573,  0.85065 }, { -0.16246,  0.26287,  0.95106 },
-      { -0.43389,  0.25989,  0.86267 }, { -0.58779,  0.42533,  0.68819 },
-      { -0.69378,  0.16062,  0.70205 }, { -0.25989,  0.86267,  0.43389 },
-      { -0.42533,  0.68819,  0.58779 }, { -0.86267,  0.43389,  0.25989 },
-      { -0.68819,  0.58779,  0.42533 }, { -0.70205,  0.69378,  0.16062 },
-      { -0.85065,  0.00000,  0.52573 }, { -0.96194,  0.27327,  0.00000 },
-      { -0.95106,  0.16246,  0.26287 }, { -0.95106, -0.16246,  0.26287 },
-      { -0.96194, -0.27327,  0.00000 }, { -0.95106, -0.16246, -0.26287 },
-      { -0.86267, -0.43389, -0.25989 }, { -0.86267,  0.43389, -0.25989 },
-      { -0.95106,  0.16246, -0.26287 }, { -0.69378, -0.16062, -0.70205 },
-      { -0.85065,  0.00000, -0.52573 }, { -0.69378,  0.16062, -0.70205 },
-      { -0.68819, -0.58779, -0.42533 }, { -0.43389, -0.25989, -0.86267 },
-      { -0.58779, -0.42533, -0.68819 }, { -0.42533, -0.68819, -0.58779 },
-      { -0.16062, -0.70205, -0.69378 }, {  0.00000, -0.52573, -0.85065 },
-      {  0.16062, -0.70205, -0.69378 }, { -0.27327,  0.00000, -0.96194 },
-      { -0.16246, -0.26287, -0.95106 }, {  0.43389, -0.25989, -0.86267 },
-      {  0.16246, -0.26287, -0.95106 }, {  0.27327,  0.00000, -0.96194 },
-      {  0.42533, -0.68819, -0.58779 }, {  0.69378, -0.16062, -0.70205 },
-      {  0.58779, -0.42533, -0.68819 }, {  0.68819, -0.58779, -0.42533 },
-      {  0.86267, -0.43389, -0.25989 }, {  0.95106, -0.16246, -0.26287 },
-      {  0.96194, -0.27327,  0.00000 }, {  0.69378,  0.16062, -0.70205 },
-      {  0.85065,  0.00000, -0.52573 }, {  0.96194,  0.27327,  0.00000 },
-      {  0.95106,  0.16246, -0.26287 }, {  0.86267,  0.43389, -0.25989 },
-      {  0.95106, -0.16246,  0.26287 }, {  0.95106,  0.16246,  0.26287 },
-      {  0.85065,  0.00000,  0.52573 }, {  0.70205,  0.69378, -0.16062 },
-      {  0.52573,  0.85065,  0.00000 }, {  0.00000,  0.96194, -0.27327 },
-      {  0.26287,  0.95106, -0.16246 }, {  0.25989,  0.86267, -0.43389 },
-      {  0.26287,  0.95106,  0.16246 }, {  0.00000,  0.96194,  0.27327 },
-      { -0.26287,  0.95106,  0.16246 }, { -0.25989,  0.86267, -0.43389 },
-      { -0.26287,  0.95106, -0.16246 }, { -0.52573,  0.85065,  0.00000 },
-      { -0.70205,  0.69378, -0.16062 }, { -0.68819,  0.58779, -0.42533 },
-      { -0.16062,  0.70205, -0.69378 }, { -0.42533,  0.68819, -0.58779 },
-      { -0.58779,  0.42533, -0.68819 }, { -0.43389,  0.25989, -0.86267 },
-      { -0.16246,  0.26287, -0.95106 }, {  0.16062,  0.70205, -0.69378 },
-      {  0.00000,  0.52573, -0.85065 }, {  0.16246,  0.26287, -0.95106 },
-      {  0.43389,  0.25989, -0.86267 }, {  0.58779,  0.42533, -0.68819 },
-      {  0.42533,  0.68819, -0.58779 }, {  0.68819,  0.58779, -0.42533 },
-      {  0.08109, -0.78384,  0.61564 }, {  0.00000, -0.71128,  0.70291 },
-      { -0.08109, -0.78384,  0.61564 }, {  0.15643, -0.51926,  0.84018 },
-      {  0.08114, -0.62024,  0.78020 }, {  0.23709, -0.60683,  0.75865 },
-      { -0.23709, -0.60683,  0.75865 }, { -0.08114, -0.62024,  0.78020 },
-      { -0.15643, -0.51926,  0.84018 }, {  0.40336,  0.00000,  0.91504 },
-      {  0.35823, -0.13166,  0.92430 }, {  0.48444, -0.13120,  0.86493 },
-      {  0.08224, -0.13307,  0.98769 }, {  0.22012, -0.13279,  0.96639 },
-      {  0.13795,  0.00000,  0.99044 }, {  0.37504, -0.38361,  0.84391 },
-      {  0.30126, -0.26408,  0.91624 }, {  0.23868, -0.38619,  0.89101 },
-      { -0.48444, -0.13120,  0.86493 }, { -0.35823, -0.13166,  0.92430 },
-      { -0.40336,  0.00000,  0.91504 }, { -0.23868, -0.38619,  0.89101 },
-      { -0.30126, -0.26408,  0.91624 }, { -0.37504, -0.38361,  0.84391 },
-      { -0.13795,  0.00000,  0.99044 }, { -0.22012, -0.13279,  0.96639 },
-      { -0.08224, -0.13307,  0.98769 }, {  0.08232, -0.39961,  0.91298 },
-      {  0.00000, -0.26640,  0.96386 }, { -0.08232, -0.39961,  0.91298 },
-      { -0.21302, -0.79265,  0.57125 }, { -0.13120, -0.86493,  0.48444 },
-      { -0.37175, -0.60150,  0.70711 }, { -0.29600, -0.70231,  0.64741 },
-      { -0.38361, -0.84391,  0.37504 }, { -0.34615, -0.78345,  0.51612 },
-      { -0.46843, -0.75794,  0.45399 }, { -0.61564, -0.08109,  0.78384 },
-      { -0.57125, -0.21302,  0.79265 }, { -0.70711, -0.37175,  0.60150 },
-      { -0.64741, -0.29600,  0.70231 }, { -0.75865, -0.23709,  0.60683 },
-      { -0.51612, -0.34615,  0.78345 }, { -0.45399, -0.46843,  0.75794 },
-      { -0.78384, -0.61564,  0.08109 }, { -0.79265, -0.57125,  0.21302 },
-      { -0.86493, -0.48444,  0.13120 }, { -0.60150, -0.70711,  0.37175 },
-      { -0.70231, -0.64741,  0.29600 }, { -0.60683, -0.75865,  0.23709 },
-      { -0.84391, -0.37504,  0.38361 }, { -0.78345, -0.51612,  0.34615 },
-      { -0.75794, -0.45399,  0.46843 }, { -0.51338, -0.56425,  0.64658 },
-      { -0.64658, -0.51338,  0.56425 }, { -0.56425, -0.64658,  0.51338 },
-      { -0.13166, -0.92430,  0.35823 }, {  0.00000, -0.91504,  0.40336 },
-      { -0.38619, -0.89101,  0.23868 }, { -0.26408, -0.91624,  0.30126 },
-      {  0.00000, -0.99044,  0.13795 }, { -0.13279, -0.96639,  0.22012 },
-      { -0.13307, -0.98769,  0.08224 }, { -0.78384, -0.61564, -0.08109 },
-      { -0.71128, -0.70291,  0.00000 }, { -0.51926, -0.84018, -0.15643 },
-      { -0.62024, -0.78020, -0.08114 }, { -0.60683, -0.75865, -0.23709 },
-      { -0.62024, -0.78020,  0.08114 }, { -0.51926, -0.84018,  0.15643 },
-      {  0.00000, -0.91504, -0.40336 }, { -0.13166, -0.92430, -0.35823 },
-      { -0.13120, -0.86493, -0.48444 }, { -0.13307, -0.98769, -0.08224 },
-      { -0.13279, -0.96639, -0.22012 }, {  0.00000, -0.99044, -0.13795 },
-      { -0.38361, -0.84391, -0.37504 }, { -0.26408, -0.91624, -0.30126 },
-      { -0.38619, -0.89101, -0.23868 }, { -0.39961, -0.91298,  0.08232 },
-      { -0.39961, -0.91298, -0.08232 }, { -0.26640, -0.96386,  0.00000 },
-      {  0.13166, -0.92430,  0.35823 }, {  0.13120, -0.86493,  0.48444 },
-      {  0.13307, -0.98769,  0.08224 }, {  0.13279, -0.96639,  0.22012 },
-      {  0.38361, -0.84391,  0.37504 }, {  0.26408, -0.91624,  0.30126 },
-      {  0.38619, -0.89101,  0.23868 }, {  0.13120, -0.86493, -0.48444 },
-      {  0.13166, -0.92430, -0.35823 }, {  0.38619, -0.89101, -0.23868 },
-      {  0.26408, -0.91624, -0.30126 }, {  0.38361, -0.84391, -0.37504 },
-      {  0.13279, -0.96639, -0.22012 }, {  0.13307, -0.98769, -0.08224 },
-      {  0.78384, -0.61564,  0.08109 }, {  0.71128, -0.70291,  0.00000 },
-      {  0.78384, -0.61564, -0.08109 }, {  0.51926, -0.84018,  0.15643 },
-      {  0.62024, -0.78020,  0.08114 }, {  0.60683, -0.75865,  0.23709 },
-      {  0.60683, -0.75865, -0.23709 }, {  0.62024, -0.78020, -0.08114 },
-      {  0.51926, -0.84018, -0.15643 }, {  0.26640, -0.96386,  0.00000 },
-      {  0.39961, -0.91298, -0.08232 }, {  0.39961, -0.91298,  0.08232 },
-      {  0.21302, -0.79265,  0.57125 }, {  0.46843, -0.75794,  0.45399 },
-      {  0.34615, -0.78345,  0.51612 }, {  0.29600, -0.70231,  0.64741 },
-      {  0.37175, -0.60150,  0.70711 }, {  0.86493, -0.48444,  0.13120 },
-      {  0.79265, -0.57125,  0.21302 }, {  0.75794, -0.45399,  0.46843 },
-      {  0.78345, -0.51612,  0.34615 }, {  0.84391, -0.37504,  0.38361 },
-      {  0.70231, -0.64741,  0.29600 }, {  0.60150, -0.70711,  0.37175 },
-      {  0.57125, -0.21302,  0.79265 }, {  0.61564, -0.08109,  0.78384 },
-      {  0.45399, -0.46843,  0.75794 }, {  0.51612, -0.34615,  0.78345 },
-      {  0.75865, -0.23709,  0.60683 }, {  0.64741, -0.29600,  0.70231 },
-      {  0.70711, -0.37175,  0.60150 }, {  0.56425, -0.64658,  0.51338 },
-      {  0.64658, -0.51338,  0.56425 }, {  0.51338, -0.56425,  0.64658 },
-      {  0.61564,  0.08109,  0.78384 }, {  0.57125,  0.21302,  0.79265 },
-      {  0.48444,  0.13120,  0.86493 }, {  0.70711,  0.37175,  0.60150 },
-      {  0.64741,  0.29600,  0.70231 }, {  0.75865,  0.23709,  0.60683 },
-      {  0.37504,  0.38361,  0.84391 }, {  0.51612,  0.34615,  0.78345 },
-      {  0.45399,  0.46843,  0.75794 }, {  0.78384,  0.61564,  0.08109 },
-      {  0.79265,  0.57125,  0.21302 }, {  0.86493,  0.48444,  0.13120 },
-      {  0.60150,  0.70711,  0.37175 }, {  0.70231,  0.64741,  0.29600 },
-      {  0.60683,  0.75865,  0.23709 }, {  0.84391,  0.37504,  0.38361 },
-      {  0.78345,  0.51612,  0.34615 }, {  0.75794,  0.45399,  0.46843 },
-      {  0.08109,  0.78384,  0.61564 }, {  0.21302,  0.79265,  0.57125 },
-      {  0.13120,  0.86493,  0.48444 }, {  0.37175,  0.60150,  0.70711 },
-      {  0.29600,  0.70231,  0.64741 }, {  0.23709,  0.60683,  0.75865 },
-      {  0.38361,  0.84391,  0.37504 }, {  0.34615,  0.78345,  0.51612 },
-      {  0.46843,  0.75794,  0.45399 }, {  0.64658,  0.51338,  0.56425 },
-      {  0.56425,  0.64658,  0.51338 }, {  0.51338,  0.56425,  0.64658 },
-      {  0.35823,  0.13166,  0.92430 }, {  0.23868,  0.38619,  0.89101 },
-      {  0.30126,  0.26408,  0.91624 }, {  0.22012,  0.13279,  0.96639 },
-      {  0.08224,  0.13307,  0.98769 }, { -0.08109,  0.78384,  0.61564 },
-      {  0.00000,  0.71128,  0.70291 }, { -0.15643,  0.51926,  0.84018 },
-      { -0.08114,  0.62024,  0.78020 }, { -0.23709,  0.60683,  0.75865 },
-      {  0.08114,  0.62024,  0.78020 }, {  0.15643,  0.51926,  0.84018 },
-      { -0.35823,  0.13166,  0.92430 }, { -0.48444,  0.13120,  0.86493 },
-      { -0.08224,  0.13307,  0.98769 }, { -0.22012,  0.13279,  0.96639 },
-      { -0.37504,  0.38361,  0.84391 }, { -0.30126,  0.26408,  0.91624 },
-      { -0.23868,  0.38619,  0.89101 }, {  0.08232,  0.39961,  0.91298 },
-      { -0.08232,  0.39961,  0.91298 }, {  0.00000,  0.26640,  0.96386 },
-      { -0.57125,  0.21302,  0.79265 }, { -0.61564,  0.08109,  0.78384 },
-      { -0.45399,  0.46843,  0.75794 }, { -0.51612,  0.34615,  0.78345 },
-      { -0.75865,  0.23709,  0.60683 }, { -0.64741,  0.29600,  0.70231 },
-      { -0.70711,  0.37175,  0.60150 }, { -0.13120,  0.86493,  0.48444 },
-      { -0.21302,  0.79265,  0.57125 }, { -0.46843,  0.75794,  0.45399 },
-      { -0.34615,  0.78345,  0.51612 }, { -0.38361,  0.84391,  0.37504 },
-      { -0.29600,  0.70231,  0.64741 }, { -0.37175,  0.60150,  0.70711 },
-      { -0.86493,  0.48444,  0.13120 }, { -0.79265,  0.57125,  0.21302 },
-      { -0.78384,  0.61564,  0.08109 }, { -0.75794,  0.45399,  0.46843 },
-      { -0.78345,  0.51612,  0.34615 }, { -0.84391,  0.37504,  0.38361 },
-      { -0.60683,  0.75865,  0.23709 }, { -0.70231,  0.64741,  0.29600 },
-      { -0.60150,  0.70711,  0.37175 }, { -0.51338,  0.56425,  0.64658 },
-      { -0.56425,  0.64658,  0.51338 }, { -0.64658,  0.51338,  0.56425 },
-      { -0.70291,  0.00000,  0.71128 }, { -0.84018,  0.15643,  0.51926 },
-      { -0.78020,  0.08114,  0.62024 }, { -0.78020, -0.08114,  0.62024 },
-      { -0.84018, -0.15643,  0.51926 }, { -0.91504,  0.40336,  0.00000 },
-      { -0.92430,  0.35823,  0.13166 }, { -0.98769,  0.08224,  0.13307 },
-      { -0.96639,  0.22012,  0.13279 }, { -0.99044,  0.13795,  0.00000 },
-      { -0.91624,  0.30126,  0.26408 }, { -0.89101,  0.23868,  0.38619 },
-      { -0.92430, -0.35823,  0.13166 }, { -0.91504, -0.40336,  0.00000 },
-      { -0.89101, -0.23868,  0.38619 }, { -0.91624, -0.30126,  0.26408 },
-      { -0.99044, -0.13795,  0.00000 }, { -0.96639, -0.22012,  0.13279 },
-      { -0.98769, -0.08224,  0.13307 }, { -0.91298,  0.08232,  0.39961 },
-      { -0.96386,  0.00000,  0.26640 }, { -0.91298, -0.08232,  0.39961 },
-      { -0.92430, -0.35823, -0.13166 }, { -0.86493, -0.48444, -0.13120 },
-      { -0.98769, -0.08224, -0.13307 }, { -0.96639, -0.22012, -0.13279 },
-      { -0.84391, -0.37504, -0.38361 }, { -0.91624, -0.30126, -0.26408 },
-      { -0.89101, -0.23868, -0.38619 }, { -0.86493,  0.48444, -0.13120 },
-      { -0.92430,  0.35823, -0.13166 }, { -0.89101,  0.23868, -0.38619 },
-      { -0.91624,  0.30126, -0.26408 }, { -0.84391,  0.37504, -0.38361 },
-      { -0.96639,  0.22012, -0.13279 }, { -0.98769,  0.08224, -0.13307 },
-      { -0.61564, -0.08109, -0.78384 }, { -0.70291,  0.00000, -0.71128 },
-      { -0.61564,  0.08109, -0.78384 }, { -0.84018, -0.15643, -0.51926 },
-      { -0.78020, -0.08114, -0.62024 }, { -0.75865, -0.23709, -0.60683 },
-      { -0.75865,  0.23709, -0.60683 }, { -0.78020,  0.08114, -0.62024 },
-      { -0.84018,  0.15643, -0.51926 }, { -0.96386,  0.00000, -0.26640 },
-      { -0.91298,  0.08232, -0.39961 }, { -0.91298, -0.08232, -0.39961 },
-      { -0.79265, -0.57125, -0.21302 }, { -0.75794, -0.45399, -0.46843 },
-      { -0.78345, -0.51612, -0.34615 }, { -0.70231, -0.64741, -0.29600 },
-      { -0.60150, -0.70711, -0.37175 }, { -0.48444, -0.13120, -0.86493 },
-      { -0.57125, -0.21302, -0.79265 }, { -0.45399, -0.46843, -0.75794 },
-      { -0.51612, -0.34615, -0.78345 }, { -0.37504, -0.38361, -0.84391 },
-      { -0.64741, -0.29600, -0.70231 }, { -0.70711, -0.37175, -0.60150 },
-      { -0.21302, -0.79265, -0.57125 }, { -0.08109, -0.78384, -0.61564 },
-      { -0.46843, -0.75794, -0.45399 }, { -0.34615, -0.78345, -0.51612 },
-      { -0.23709, -0.60683, -0.75865 }, { -0.29600, -0.70231, -0.64741 },
-      { -0.37175, -0.60150, -0.70711 }, { -0.64658, -0.51338, -0.56425 },
-      { -0.51338, -0.56425, -0.64658 }, { -0.56425, -0.64658, -0.51338 },
-      {  0.00000, -0.71128, -0.70291 }, {  0.08109, -0.78384, -0.61564 },
-      { -0.15643, -0.51926, -0.84018 }, { -0.08114, -0.62024, -0.78020 },
-      {  0.23709, -0.60683, -0.75865 }, {  0.08114, -0.62024, -0.78020 },
-      {  0.15643, -0.51926, -0.84018 }, { -0.40336,  0.00000, -0.91504 },
-      { -0.35823, -0.13166, -0.92430 }, { -0.08224, -0.13307, -0.98769 },
-      { -0.22012, -0.13279, -0.96639 }, { -0.13795,  0.00000, -0.99044 },
-      { -0.30126, -0.26408, -0.91624 }, { -0.23868, -0.38619, -0.89101 },
-      {  0.48444, -0.13120, -0.86493 }, {  0.35823, -0.13166, -0.92430 },
-      {  0.40336,  0.00000, -0.91504 }, {  0.23868, -0.38619, -0.89101 },
-      {  0.30126, -0.26408, -0.91624 }, {  0.37504, -0.38361, -0.84391 },
-      {  0.13795,  0.00000, -0.99044 }, {  0.22012, -0.13279, -0.96639 },
-      {  0.08224, -0.13307, -0.98769 }, { -0.08232, -0.39961, -0.91298 },
-      {  0.00000, -0.26640, -0.96386 }, {  0.08232, -0.39961, -0.91298 },
-      {  0.21302, -0.79265, -0.57125 }, {  0.37175, -0.60150, -0.70711 },
-      {  0.29600, -0.70231, -0.64741 }, {  0.34615, -0.78345, -0.51612 },
-      {  0.46843, -0.75794, -0.45399 }, {  0.61564, -0.08109, -0.78384 },
-      {  0.57125, -0.21302, -0.79265 }, {  0.70711, -0.37175, -0.60150 },
-      {  0.64741, -0.29600, -0.70231 }, {  0.75865, -0.23709, -0.60683 },
-      {  0.51612, -0.34615, -0.78345 }, {  0.45399, -0.46843, -0.75794 },
-      {  0.79265, -0.57125, -0.21302 }, {  0.86493, -0.48444, -0.13120 },
-      {  0.60150, -0.70711, -0.37175 }, {  0.70231, -0.64741, -0.29600 },
-      {  0.84391, -0.37504, -0.38361 }, {  0.78345, -0.51612, -0.34615 },
-      {  0.75794, -0.45399, -0.46843 }, {  0.51338, -0.56425, -0.64658 },
-      {  0.64658, -0.51338, -0.56425 }, {  0.56425, -0.64658, -0.51338 },
-      {  0.92430, -0.35823, -0.13166 }, {  0.91504, -0.40336,  0.00000 },
-      {  0.89101, -0.23868, -0.38619 }, {  0.91624, -0.30126, -0.26408 },
-      {  0.99044, -0.13795,  0.00000 }, {  0.96639, -0.22012, -0.13279 },
-      {  0.98769, -0.08224, -0.13307 }, {  0.61564,  0.08109, -0.78384 },
-      {  0.70291,  0.00000, -0.71128 }, {  0.84018,  0.15643, -0.51926 },
-      {  0.78020,  0.08114, -0.62024 }, {  0.75865,  0.23709, -0.60683 },
-      {  0.78020, -0.08114, -0.62024 }, {  0.84018, -0.15643, -0.51926 },
-      {  0.91504,  0.40336,  0.00000 }, {  0.92430,  0.35823, -0.13166 },
-      {  0.86493,  0.48444, -0.13120 }, {  0.98769,  0.08224, -0.13307 },
-      {  0.96639,  0.22012, -0.13279 }, {  0.99044,  0.13795,  0.00000 },
-      {  0.84391,  0.37504, -0.38361 }, {  0.91624,  0.30126, -0.26408 },
-      {  0.89101,  0.23868, -0.38619 }, {  0.91298, -0.08232, -0.39961 },
-      {  0.91298,  0.08232, -0.39961 }, {  0.96386,  0.00000, -0.26640 },
-      {  0.92430, -0.35823,  0.13166 }, {  0.98769, -0.08224,  0.13307 },
-      {  0.96639, -0.22012,  0.13279 }, {  0.91624, -0.30126,  0.26408 },
-      {  0.89101, -0.23868,  0.38619 }, {  0.92430,  0.35823,  0.13166 },
-      {  0.89101,  0.23868,  0.38619 }, {  0.91624,  0.30126,  0.26408 },
-      {  0.96639,  0.22012,  0.13279 }, {  0.98769,  0.08224,  0.13307 },
-      {  0.70291,  0.00000,  0.71128 }, {  0.84018, -0.15643,  0.51926 },
-      {  0.78020, -0.08114,  0.62024 }, {  0.78020,  0.08114,  0.62024 },
-      {  0.84018,  0.15643,  0.51926 }, {  0.96386,  0.00000,  0.26640 },
-      {  0.91298,  0.08232,  0.39961 }, {  0.91298, -0.08232,  0.39961 },
-      {  0.78384,  0.61564, -0.08109 }, {  0.71128,  0.70291,  0.00000 },
-      {  0.51926,  0.84018, -0.15643 }, {  0.62024,  0.78020, -0.08114 },
-      {  0.60683,  0.75865, -0.23709 }, {  0.62024,  0.78020,  0.08114 },
-      {  0.51926,  0.84018,  0.15643 }, {  0.00000,  0.91504, -0.40336 },
-      {  0.13166,  0.92430, -0.35823 }, {  0.13120,  0.86493, -0.48444 },
-      {  0.13307,  0.98769, -0.08224 }, {  0.13279,  0.96639, -0.22012 },
-      {  0.00000,  0.99044, -0.13795 }, {  0.38361,  0.84391, -0.37504 },
-      {  0.26408,  0.91624, -0.30126 }, {  0.38619,  0.89101, -0.23868 },
-      {  0.13166,  0.92430,  0.35823 }, {  0.00000,  0.91504,  0.40336 },
-      {  0.38619,  0.89101,  0.23868 }, {  0.26408,  0.91624,  0.30126 },
-      {  0.00000,  0.99044,  0.13795 }, {  0.13279,  0.96639,  0.22012 },
-      {  0.13307,  0.98769,  0.08224 }, {  0.39961,  0.91298, -0.08232 },
-      {  0.26640,  0.96386,  0.00000 }, {  0.39961,  0.91298,  0.08232 },
-      { -0.13166,  0.92430,  0.35823 }, { -0.13307,  0.98769,  0.08224 },
-      { -0.13279,  0.96639,  0.22012 }, { -0.26408,  0.91624,  0.30126 },
-      { -0.38619,  0.89101,  0.23868 }, { -0.13120,  0.86493, -0.48444 },
-      { -0.13166,  0.92430, -0.35823 }, { -0.38619,  0.89101, -0.23868 },
-      { -0.26408,  0.91624, -0.30126 }, { -0.38361,  0.84391, -0.37504 },
-      { -0.13279,  0.96639, -0.22012 }, { -0.13307,  0.98769, -0.08224 },
-      { -0.71128,  0.70291,  0.00000 }, { -0.78384,  0.61564, -0.08109 },
-      { -0.51926,  0.84018,  0.15643 }, { -0.62024,  0.78020,  0.08114 },
-      { -0.60683,  0.75865, -0.23709 }, { -0.62024,  0.78020, -0.08114 },
-      { -0.51926,  0.84018, -0.15643 }, { -0.26640,  0.96386,  0.00000 },
-      { -0.39961,  0.91298, -0.08232 }, { -0.39961,  0.91298,  0.08232 },
-      { -0.79265,  0.57125, -0.21302 }, { -0.60150,  0.70711, -0.37175 },
-      { -0.70231,  0.64741, -0.29600 }, { -0.78345,  0.51612, -0.34615 },
-      { -0.75794,  0.45399, -0.46843 }, { -0.08109,  0.78384, -0.61564 },
-      { -0.21302,  0.79265, -0.57125 }, { -0.37175,  0.60150, -0.70711 },
-      { -0.29600,  0.70231, -0.64741 }, { -0.23709,  0.60683, -0.75865 },
-      { -0.34615,  0.78345, -0.51612 }, { -0.46843,  0.75794, -0.45399 },
-      { -0.57125,  0.21302, -0.79265 }, { -0.48444,  0.13120, -0.86493 },
-      { -0.70711,  0.37175, -0.60150 }, { -0.64741,  0.29600, -0.70231 },
-      { -0.37504,  0.38361, -0.84391 }, { -0.51612,  0.34615, -0.78345 },
-      { -0.45399,  0.46843, -0.75794 }, { -0.56425,  0.64658, -0.51338 },
-      { -0.51338,  0.56425, -0.64658 }, { -0.64658,  0.51338, -0.56425 },
-      { -0.35823,  0.13166, -0.92430 }, { -0.23868,  0.38619, -0.89101 },
-      { -0.30126,  0.26408, -0.91624 }, { -0.22012,  0.13279, -0.96639 },
-      { -0.08224,  0.13307, -0.98769 }, {  0.08109,  0.78384, -0.61564 },
-      {  0.00000,  0.71128, -0.70291 }, {  0.15643,  0.51926, -0.84018 },
-      {  0.08114,  0.62024, -0.78020 }, {  0.23709,  0.60683, -0.75865 },
-      { -0.08114,  0.62024, -0.78020 }, { -0.15643,  0.51926, -0.84018 },
-      {  0.35823,  0.13166, -0.92430 }, {  0.48444,  0.13120, -0.86493 },
-      {  0.08224,  0.13307, -0.98769 }, {  0.22012,  0.13279, -0.96639 },
-      {  0.37504,  0.38361, -0.84391 }, {  0.30126,  0.26408, -0.91624 },
-      {  0.23868,  0.38619, -0.89101 }, { -0.08232,  0.39961, -0.91298 },
-      {  0.08232,  0.39961, -0.91298 }, {  0.00000,  0.26640, -0.96386 },
-      {  0.57125,  0.21302, -0.79265 }, {  0.45399,  0.46843, -0.75794 },
-      {  0.51612,  0.34615, -0.78345 }, {  0.64741,  0.29600, -0.70231 },
-      {  0.70711,  0.37175, -0.60150 }, {  0.21302,  0.79265, -0.57125 },
-      {  0.46843,  0.75794, -0.45399 }, {  0.34615,  0.78345, -0.51612 },
-      {  0.29600,  0.70231, -0.64741 }, {  0.37175,  0.60150, -0.70711 },
-      {  0.79265,  0.57125, -0.21302 }, {  0.75794,  0.45399, -0.46843 },
-      {  0.78345,  0.51612, -0.34615 }, {  0.70231,  0.64741, -0.29600 },
-      {  0.60150,  0.70711, -0.37175 }, {  0.51338,  0.56425, -0.64658 },
-      {  0.56425,  0.64658, -0.51338 }, {  0.64658,  0.51338, -0.56425 }
-    };
 };
 
 #endif
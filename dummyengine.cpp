@@ -1,74 +1,441 @@
 #include "dummyengine.h"
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <glm/glm.hpp>
+#include "aabb.h"
+#include "aabbtree.h"
+#include "broadphase.h"
+#include "boxcollision.h"
+#include "checkpoint.h"
 #include "collision.h"
+#include "contact.h"
+#include "convexcollision.h"
+#include "cuboid.h"
+#include "eventlog.h"
+#include "eventqueue.h"
 #include "motionengine.h"
 #include "object.h"
+#include "posebatch.h"
+#include "profiler.h"
+#include "shape.h"
+#include "spatialhash.h"
 #include "state.h"
+#include "supportmapping.h"
+#include "sweepandprune.h"
+#include "threadpool.h"
+#include "timelines.h"
+#include "timeofimpact.h"
+#include "unionfind.h"
+
+#define PREDICTION_HORIZON 1.0
+#define CONTACT_MARGIN 2e-3f
+#define SEPARATING_ATTEMPTS 8
+#define SEPARATING_STEP 1e-3f
+#define PARALLEL_ISLANDS 8  // fewer than this are not worth waking the pool for
 
 using namespace std;
 
-DummyEngine::DummyEngine() { }
+DummyEngine::DummyEngine() {
+  threads_ = 1;
+  event_log_ = NULL;
+}
+
+DummyEngine::DummyEngine(MotionEngine & motionengine,
+                         const vector<Object*> & objects)
+  : DummyEngine(motionengine, objects, headOnMotion(objects.size())) { }
 
 DummyEngine::DummyEngine(MotionEngine & motionengine,
-                         const vector<Object*> & objects) {
+                         const vector<Object*> & objects,
+                         const vector<CollisionEvent> & initial_events) {
   motionengine_ = &motionengine;
   objects_ = &objects;
+  time_ = 0.0f;
+  event_log_ = NULL;
+  timeofimpact_ = TimeOfImpact(motionengine);
+  collision_ = Collision(objects);
+
+  // one support mapping per distinct shape, not per object
+  map<Shape const *, int> shape_index;
+  for (int i = 0; i < objects.size(); i++) {
+    float radius = 0.0f;
+    for (int j = 0; j < objects[i]->numverts(); j++) {
+      radius = max(radius, glm::length(glm::vec3(objects[i]->verts()[j])));
+    }
+    radii_.push_back(radius);
+    Shape const * shape = objects[i]->shape();
+    if (shape_index.find(shape) == shape_index.end()) {
+      shape_index[shape] = supports_.size();
+      supports_.push_back(SupportMapping(*objects[i]));
+    }
+    support_index_.push_back(shape_index[shape]);
+    started_.push_back(false);
+  }
+  event_queue_.resize(objects.size());
+  islands_.resize(objects.size());
+
+  // Grid cells are sized after the typical swept box rather than the
+  // typical object, or fast objects would each span a great many cells.
+  vector<float> extents;
+  for (int i = 0; i < objects.size(); i++) {
+    extents.push_back(2.0f * radii_[i]);
+  }
+  for (int i = 0; i < initial_events.size(); i++) {
+    glm::vec3 velocity = glm::abs(*initial_events[i].velocity());
+    float speed = max(velocity.x, max(velocity.y, velocity.z));
+    int id = initial_events[i].object();
+    extents[id] = 2.0f * radii_[id] + 2 * PREDICTION_HORIZON * speed;
+  }
+  cell_size_ = 1.0f;
+  if (extents.size() > 0) {
+    nth_element(extents.begin(), extents.begin() + extents.size() / 2, extents.end());
+    cell_size_ = extents[extents.size() / 2];
+  }
+  setBroadPhase(AABB_TREE);
+  setThreads(thread::hardware_concurrency());
   
   for (int i = 0; i < objects.size(); i++) {
     last_events_.push_back(CollisionEvent(i,                       // object id
                                      0.0,                          // time
                                      glm::vec3(0.0f, 0.0f, 0.0f),  // initial_coordinates
-                                     glm::vec3(0.0f, 0.0f, 1.0f),  // initial_axis
-                                     0.0f,                         // initial_angle
+                                     glm::quat(1.0f, 0.0f, 0.0f, 0.0f),  // initial_orientation
                                      glm::vec3(1.0f, 0.0f, 0.0f),  // axis_of_rotation
                                      glm::vec3(0.0f, 0.0f, 0.0f),  // velocity
                                      0.0f));                       // angular_velocity
   }
-
+  posebatch_.resize(objects.size());
+  timelines_.resize(objects.size());
   for (int i = 0; i < objects.size(); i++) {
-    event_queue_.push(CollisionEvent(i,                       // object id
-                                     0.0,                          // time
-                                     glm::vec3((i - 0.5) * 4.0f, 0.0f, 0.0f),  // initial_coordinates
-                                     glm::vec3(0.0f, 0.0f, 1.0f),  // initial_axis
-                                     0.0f,                         // initial_angle
-                                     glm::vec3(1.0f, 0.0f, 0.0f),  // axis_of_rotation
-                                     glm::vec3(-4.0f * (i - 0.5), 0.0f, 0.0f),  // velocity
-                                     0.0f));                       // angular_velocity
+    posebatch_.set(last_events_[i]);
+    timelines_.append(last_events_[i]);
+  }
+
+  for (int i = 0; i < initial_events.size(); i++) {
+    event_queue_.force(initial_events[i]);
+  }
+}
+
+// objects on the x axis 4 apart, flying at each other
+vector<CollisionEvent> DummyEngine::headOnMotion(int num_objects) {
+  vector<CollisionEvent> events;
+  for (int i = 0; i < num_objects; i++) {
+    events.push_back(CollisionEvent(i,                       // object id
+                                    0.0,                          // time
+                                    glm::vec3((i - 0.5) * 4.0f, 0.0f, 0.0f),  // initial_coordinates
+                                    glm::quat(1.0f, 0.0f, 0.0f, 0.0f),  // initial_orientation
+                                    glm::vec3(1.0f, 0.0f, 0.0f),  // axis_of_rotation
+                                    glm::vec3(-4.0f * (i - 0.5), 0.0f, 0.0f),  // velocity
+                                    0.0f));                       // angular_velocity
   }
+  return events;
 }
 
-void DummyEngine::randomEvent(int object_id) {
+// Refits and queries only this object's leaf, the other boxes are kept up
+// to date as their own events are applied.
+void DummyEngine::randomEvent(int object_id, float start) {
+  AABB box;
+  sweptBounds(object_id, start - last_events_[object_id].time() + 2 * PREDICTION_HORIZON, box);
+  broadphase_->update(object_id, box);
+  candidates_.clear();
+  broadphase_->query(object_id, candidates_);
+
+  Prediction prediction;
+  predict(object_id, start, candidates_.empty() ? NULL : &candidates_[0], candidates_.size(),
+          prediction);
+  schedule(prediction);
+}
+
+// The next collision of an object after start and within the prediction
+// horizon, or a re-check at the end of it if there is none. A pair the time
+// of impact search gave up on brings the re-check forward to where it got
+// to. Only reads the engine, so any number of these can run at once.
+//
+// The horizon ends a fixed time after the object's latest event rather than
+// after start, so a re-check lands at the same time however often and
+// wherever the object is predicted again, orphaned or installed.
+void DummyEngine::predict(int object_id, float start, int const * candidates, int num_candidates,
+                          Prediction & prediction) const {
   int i = object_id;
-  Collision collision = Collision(*objects_);
-  CollisionEvent newcol_a, newcol_b;
-  collision.generateCollisionEvents(last_events_[i].time() + .7,
-                                    glm::vec3(0.0f, 0.0f, 0.0f),
-                                    0,
-                                    1,
-                                    last_events_[0],
-                                    last_events_[1],
-                                    newcol_a,
-                                    newcol_b);
-  event_queue_.push(newcol_a);
-  event_queue_.push(newcol_b);
+  float end = max(start, last_events_[i].time() + (float)PREDICTION_HORIZON);
+
+  PROFILE_SCOPE(PHASE_NARROW_PHASE);
+  PROFILE_COUNT(COUNTER_PAIRS_TESTED, num_candidates);
+  int first = -1;  // none, so a re-check at first_time
+  float first_time = end;
+  Contact first_contact;
+  for (int k = 0; k < num_candidates; k++) {
+    int other = candidates[k];
+    // the lower id goes first, so that the pair comes out the same whichever
+    // of them is being predicted, in this engine or in another region's
+    int a = min(i, other);
+    int b = max(i, other);
+    float time;
+    Contact contact;
+
+    // Searched from the later of the two events rather than from start, for
+    // the same reason. A contact found before start was passed already, so
+    // that one is looked for again from start.
+    float from = min(start, max(last_events_[a].time(), last_events_[b].time()));
+    ImpactResult result = firstContact(a, b, from, first_time, time, contact);
+    if (result != IMPACT_NONE && time < start) {
+      result = firstContact(a, b, start, first_time, time, contact);
+    }
+    if (result == IMPACT_NONE) {
+      continue;
+    }
+    if (result == IMPACT_UNRESOLVED) {
+      // past start, or the re-check would come round again right away
+      time = max(time, nextafterf(start, FLT_MAX));
+      if (time < first_time) {
+        first = -1;
+        first_time = time;
+      }
+      continue;
+    }
+    PROFILE_COUNT(COUNTER_PAIRS_COLLIDING, 1);
+
+    // ties go to the lower id, the broad phase lists candidates in any order
+    if (first == -1 || time < first_time || (time == first_time && other < first)) {
+      first = other;
+      first_time = time;
+      first_contact = contact;
+    }
+  }
+
+  if (first == -1) {
+    motionengine_->advance(last_events_[i], first_time, prediction.events[0]);
+    prediction.count = 1;
+    return;
+  }
+
+  int a = min(i, first);
+  int b = max(i, first);
+  collision_.generateCollisionEvents(first_time,
+                                     first_contact.center(),
+                                     first_contact.normal(),
+                                     a,
+                                     b,
+                                     last_events_[a],
+                                     last_events_[b],
+                                     prediction.events[0],
+                                     prediction.events[1]);
+  prediction.count = 2;
 }
 
-void DummyEngine::getState(int object_id, float time, State & state) {
-  while (event_queue_.size() > 0 && time > event_queue_.front().time()) {
-    CollisionEvent & col = event_queue_.front();
-    event_queue_.pop();
-    last_events_[col.object()] = col;
+// When two objects next touch while approaching each other, from start and
+// up to end.
+ImpactResult DummyEngine::firstContact(int object_a, int object_b, float start, float end,
+                                       float & time, Contact & contact) const {
+  // The impulse goes through the refined contact, and objects that are
+  // already separating there would be pulled back together by it. So
+  // look again a little later, as they can still turn into each other.
+  float from = start;
+  for (int attempt = 0; attempt < SEPARATING_ATTEMPTS; attempt++) {
+    // already overlapping, so resolve it right away
+    if (attempt == 0 && narrowPhase(object_a, object_b, start, contact) &&
+        approaching(object_a, object_b, start, contact)) {
+      time = start;
+    } else {
+      ImpactResult result = timeofimpact_.solve(supports_[support_index_[object_a]],
+                                                radii_[object_a], last_events_[object_a],
+                                                supports_[support_index_[object_b]],
+                                                radii_[object_b], last_events_[object_b],
+                                                from, end, time, contact);
+      if (result != IMPACT_FOUND) {
+        return result;
+      }
+    }
+    refineContact(object_a, object_b, time, contact);
+    if (approaching(object_a, object_b, time, contact)) {
+      return IMPACT_FOUND;
+    }
+    from = time + SEPARATING_STEP;
+  }
+  return IMPACT_NONE;
+}
 
-    randomEvent(col.object());
+// Predicts every object in touched_, one island at a time. The broad phase
+// keeps scratch state of its own, so it is queried up front, and the
+// predictions are scheduled in order of object id afterwards, which keeps
+// the result the same no matter how the islands were spread over threads.
+void DummyEngine::predictAll(float start) {
+  sort(touched_.begin(), touched_.end());
+  touched_.erase(unique(touched_.begin(), touched_.end()), touched_.end());
+  int n = touched_.size();
+
+  candidate_offsets_.resize(n + 1);
+  candidate_ids_.clear();
+  members_.clear();
+  {
+    PROFILE_SCOPE(PHASE_BROAD_PHASE);
+    for (int k = 0; k < n; k++) {
+      candidate_offsets_[k] = candidate_ids_.size();
+      broadphase_->query(touched_[k], candidate_ids_);
+      members_.push_back(make_pair(islands_.find(touched_[k]), k));
+    }
+    candidate_offsets_[n] = candidate_ids_.size();
+  }
+
+  sort(members_.begin(), members_.end());
+  island_offsets_.clear();
+  for (int k = 0; k < n; k++) {
+    if (k == 0 || members_[k].first != members_[k - 1].first) {
+      island_offsets_.push_back(k);
+    }
   }
+  int num_islands = island_offsets_.size();
+  island_offsets_.push_back(n);
+
+  predictions_.resize(n);
+  function<void(int, int)> predictIsland = [this, start](int island, int /*worker*/) {
+    for (int m = island_offsets_[island]; m < island_offsets_[island + 1]; m++) {
+      int k = members_[m].second;
+      int offset = candidate_offsets_[k];
+      predict(touched_[k], start, candidate_ids_.data() + offset, candidate_offsets_[k + 1] - offset,
+              predictions_[k]);
+    }
+  };
+  if (threads_ > 1 && num_islands >= PARALLEL_ISLANDS) {
+    if (!pool_) {
+      pool_ = make_shared<ThreadPool>(threads_);
+    }
+    pool_->run(num_islands, predictIsland);
+  } else {
+    for (int k = 0; k < num_islands; k++) {
+      predictIsland(k, 0);
+    }
+  }
+
+  for (int k = 0; k < n; k++) {
+    schedule(predictions_[k]);
+    islands_.reset(touched_[k]);
+  }
+}
+
+void DummyEngine::schedule(Prediction const & prediction) {
+  if (prediction.count == 1) {
+    event_queue_.schedule(prediction.events[0]);
+  } else {
+    event_queue_.schedule(prediction.events[0], prediction.events[1]);
+  }
+}
+
+void DummyEngine::getState(int object_id, float time, State & state) {
+  processEvents(time, INT_MAX);
 
   Object * object = (*objects_)[object_id];
   state.setVerts(*(object->verts()));
   state.setTris(*(object->tris()));
 
-  motionengine_->pose(last_events_[object_id], time, *state.pose());
+  motionengine_->pose(timelines_.at(object_id, time), time, *state.pose());
+}
+
+void DummyEngine::getStates(float time, vector<State> & states) {
+  processEvents(time, INT_MAX);
+
+  states.resize(objects_->size());
+  getPoses(time, poses_);
+  for (int i = 0; i < objects_->size(); i++) {
+    Object * object = (*objects_)[i];
+    states[i].setVerts(*(object->verts()));
+    states[i].setTris(*(object->tris()));
+    *states[i].pose() = poses_[i];
+  }
+}
+
+void DummyEngine::getPoses(float time, vector<glm::mat4> & poses) {
+  processEvents(time, INT_MAX);
+
+  poses.resize(posebatch_.size());
+  if (poses.empty()) {
+    return;
+  }
+  // the latest events only hold for times after all of them
+  if (time > time_) {
+    posebatch_.evaluate(time, &poses[0]);
+    return;
+  }
+  for (int i = 0; i < poses.size(); i++) {
+    motionengine_->pose(timelines_.at(i, time), time, poses[i]);
+  }
+}
+
+// Applies pending events earlier than time, at most max_events of them, and
+// returns how many were applied.
+int DummyEngine::processEvents(float time, int max_events) {
+  int applied = 0;
+
+  // Predictions made after each batch can be earlier than anything left
+  // in the queue, so keep going until the queue has caught up with time.
+  while (!event_queue_.empty() && time > event_queue_.time() &&
+         applied + event_queue_.count() <= max_events) {
+    float now = event_queue_.time();
+    int batch = 0;
+    orphans_.clear();
+    touched_.clear();
+
+    while (!event_queue_.empty() && event_queue_.time() == now &&
+           applied + batch + event_queue_.count() <= max_events) {
+      int count;
+      {
+        PROFILE_SCOPE(PHASE_EVENT_POP);
+        count = event_queue_.pop(popped_, orphans_);
+      }
+
+      for (int k = 0; k < count; k++) {
+        int id = popped_[k].object();
+        last_events_[id] = popped_[k];
+        timelines_.append(popped_[k]);
+        posebatch_.set(popped_[k]);
+        started_[id] = true;
+        touched_.push_back(id);
+        if (event_log_ != NULL) {
+          event_log_->append(popped_[k]);
+        }
+
+        // Only the leaf of an object whose motion changed needs refitting.
+        // Every object has an event at least once per horizon, so two
+        // horizons cover any prediction made before its next one.
+        PROFILE_SCOPE(PHASE_BROAD_PHASE);
+        AABB box;
+        sweptBounds(id, 2 * PREDICTION_HORIZON, box);
+        broadphase_->update(id, box);
+      }
+      if (count == 2) {
+        islands_.join(popped_[0].object(), popped_[1].object());
+      }
+      batch += count;
+    }
+
+    touched_.insert(touched_.end(), orphans_.begin(), orphans_.end());
+    predictAll(now);
+    PROFILE_COUNT(COUNTER_EVENTS, batch);
+    PROFILE_QUEUE_DEPTH(event_queue_.size());
+
+    applied += batch;
+    if (batch > 0) {
+      time_ = now;
+    }
+  }
+  return applied;
+}
+
+float DummyEngine::time() const {
+  return time_;
+}
+
+float DummyEngine::nextTime() const {
+  return event_queue_.empty() ? FLT_MAX : event_queue_.time();
 }
 
 int DummyEngine::numObjects() const {
@@ -76,5 +443,192 @@ int DummyEngine::numObjects() const {
 }
 
 void DummyEngine::pushEvent(CollisionEvent const & col) {
-  event_queue_.push(col); 
+  event_queue_.force(col);
+}
+
+void DummyEngine::deactivate(int object_id) {
+  started_[object_id] = false;
+  broadphase_->remove(object_id);
+  event_queue_.invalidate(object_id);
+}
+
+void DummyEngine::install(vector<CollisionEvent> const & events, float start) {
+  touched_.clear();
+  for (int k = 0; k < events.size(); k++) {
+    CollisionEvent const & event = events[k];
+    int id = event.object();
+    last_events_[id] = event;
+    if (event.time() < timelines_.latest(id).time()) {
+      timelines_.reset(event);
+    } else {
+      timelines_.append(event);
+    }
+    posebatch_.set(event);
+    started_[id] = true;
+    // what was predicted for it went by the motion it had before
+    event_queue_.invalidate(id);
+    touched_.push_back(id);
+
+    // the event can be from before start, the bounds have to reach as far
+    // past start as those of an event applied there
+    AABB box;
+    sweptBounds(id, start - event.time() + 2 * PREDICTION_HORIZON, box);
+    broadphase_->update(id, box);
+  }
+  predictAll(start);
+}
+
+CollisionEvent const & DummyEngine::latestEvent(int object_id) const {
+  return last_events_[object_id];
+}
+
+// Threads used for predicting independent islands, 1 keeps it all on the
+// calling thread.
+void DummyEngine::setThreads(int threads) {
+  threads_ = max(threads, 1);
+  pool_.reset();
+}
+
+void DummyEngine::setEventLog(EventLog * log) {
+  event_log_ = log;
+}
+
+// The shapes are saved by their index in supports_, along with their size
+// so that a restore can tell whether they are the same.
+bool DummyEngine::saveCheckpoint(char const * path) const {
+  CheckpointWriter writer;
+  if (!writer.open(path, objects_->size(), time_)) {
+    return false;
+  }
+
+  vector<glm::vec3> extents(supports_.size());
+  for (int i = 0; i < objects_->size(); i++) {
+    extents[support_index_[i]] = (*objects_)[i]->shape()->halfExtents();
+  }
+  vector<uint8_t> started(started_.begin(), started_.end());
+
+  writer.write(extents.data(), extents.size() * sizeof(glm::vec3));
+  writer.write(support_index_.data(), support_index_.size() * sizeof(int));
+  writer.write(last_events_.data(), last_events_.size() * sizeof(CollisionEvent));
+  writer.write(started.data(), started.size());
+  event_queue_.save(writer);
+  return writer.close();
+}
+
+bool DummyEngine::restoreCheckpoint(char const * path) {
+  CheckpointReader reader;
+  if (!reader.open(path)) {
+    return false;
+  }
+  int n = objects_->size();
+  size_t extents_size, index_size, events_size, started_size;
+  glm::vec3 const * extents = (glm::vec3 const *)reader.read(extents_size);
+  int const * index = (int const *)reader.read(index_size);
+  CollisionEvent const * events = (CollisionEvent const *)reader.read(events_size);
+  uint8_t const * started = (uint8_t const *)reader.read(started_size);
+
+  if (extents == NULL || index == NULL || events == NULL || started == NULL) {
+    fprintf(stderr, "%s: damaged checkpoint\n", path);
+    return false;
+  }
+  bool same_objects = reader.numObjects() == n &&
+                      extents_size == supports_.size() * sizeof(glm::vec3) &&
+                      index_size == n * sizeof(int) &&
+                      memcmp(index, support_index_.data(), index_size) == 0;
+  for (int i = 0; i < n && same_objects; i++) {
+    same_objects = extents[support_index_[i]] == (*objects_)[i]->shape()->halfExtents();
+  }
+  if (!same_objects) {
+    fprintf(stderr, "%s: checkpoint of other objects\n", path);
+    return false;
+  }
+  // nothing fails after the queue, so a bad checkpoint leaves the engine as it was
+  if (events_size != n * sizeof(CollisionEvent) || started_size != n ||
+      !event_queue_.restore(reader)) {
+    fprintf(stderr, "%s: damaged checkpoint\n", path);
+    return false;
+  }
+
+  time_ = reader.time();
+  last_events_.assign(events, events + n);
+  for (int i = 0; i < n; i++) {
+    started_[i] = (started[i] != 0);
+    posebatch_.set(last_events_[i]);
+    timelines_.reset(last_events_[i]);
+  }
+  setBroadPhase(broadphase_type_);
+  return true;
+}
+
+void DummyEngine::setBroadPhase(BroadPhaseType type) {
+  broadphase_type_ = type;
+  if (type == SWEEP_AND_PRUNE) {
+    broadphase_ = make_shared<SweepAndPrune>();
+  } else if (type == SPATIAL_HASH) {
+    broadphase_ = make_shared<SpatialHash>(cell_size_);
+  } else {
+    broadphase_ = make_shared<AABBTree>();
+  }
+
+  for (int i = 0; i < started_.size(); i++) {
+    if (started_[i]) {
+      AABB box;
+      sweptBounds(i, 2 * PREDICTION_HORIZON, box);
+      broadphase_->update(i, box);
+    }
+  }
+}
+
+// Boxes get the closed form test, anything else the generic convex one. The
+// contact normal points from object_b towards object_a.
+bool DummyEngine::narrowPhase(int object_a, int object_b, float time, Contact & contact) const {
+  glm::mat4 pose_a, pose_b;
+  motionengine_->pose(last_events_[object_a], time, pose_a);
+  motionengine_->pose(last_events_[object_b], time, pose_b);
+
+  Cuboid const * cuboid_a = dynamic_cast<Cuboid const *>((*objects_)[object_a]);
+  Cuboid const * cuboid_b = dynamic_cast<Cuboid const *>((*objects_)[object_b]);
+  if (cuboid_a != NULL && cuboid_b != NULL) {
+    return boxcollision_.intersect(*cuboid_a, pose_a, *cuboid_b, pose_b, contact);
+  }
+  return convexcollision_.intersect(supports_[support_index_[object_a]], pose_a,
+                                    supports_[support_index_[object_b]], pose_b,
+                                    contact);
+}
+
+// Conservative advancement stops just short of the contact and only finds
+// the closest pair of points. Two boxes can touch along a whole face or
+// edge, so look for their full contact within that gap instead.
+void DummyEngine::refineContact(int object_a, int object_b, float time, Contact & contact) const {
+  Cuboid const * cuboid_a = dynamic_cast<Cuboid const *>((*objects_)[object_a]);
+  Cuboid const * cuboid_b = dynamic_cast<Cuboid const *>((*objects_)[object_b]);
+  if (cuboid_a == NULL || cuboid_b == NULL) {
+    return;
+  }
+
+  glm::mat4 pose_a, pose_b;
+  motionengine_->pose(last_events_[object_a], time, pose_a);
+  motionengine_->pose(last_events_[object_b], time, pose_b);
+  Contact manifold;
+  if (boxcollision_.intersect(*cuboid_a, pose_a, *cuboid_b, pose_b, CONTACT_MARGIN, manifold)) {
+    contact = manifold;
+  }
+}
+
+bool DummyEngine::approaching(int object_a, int object_b, float time, Contact const & contact) const {
+  glm::vec3 velocity_a, velocity_b;
+  motionengine_->velocityAt(last_events_[object_a], time, contact.center(), velocity_a);
+  motionengine_->velocityAt(last_events_[object_b], time, contact.center(), velocity_b);
+  return glm::dot(velocity_a - velocity_b, contact.normal()) < 0.0f;
+}
+
+// Bounds the object over the next duration of its current motion. Using the
+// bounding sphere makes the box independent of the orientation.
+void DummyEngine::sweptBounds(int object_id, float duration, AABB & box) const {
+  CollisionEvent const & event = last_events_[object_id];
+  glm::vec3 start = *event.initial_coordinates();
+  glm::vec3 end = start + duration * *event.velocity();
+  glm::vec3 radius = glm::vec3(radii_[object_id]);
+
+  box.setBounds(glm::min(start, end) - radius, glm::max(start, end) + radius);
 }
@@ -1,25 +1,125 @@
 #ifndef DUMMYENGINE_H
 #define DUMMYENGINE_H
 #include "collisionevent.h"
-#include <queue>
+#include <memory>
+#include <utility>
 #include <vector>
+#include <glm/glm.hpp>
+#include "aabb.h"
+#include "boxcollision.h"
+#include "broadphase.h"
+#include "checkpoint.h"
+#include "collision.h"
+#include "contact.h"
+#include "convexcollision.h"
+#include "eventlog.h"
+#include "eventqueue.h"
 #include "motionengine.h"
 #include "object.h"
+#include "posebatch.h"
 #include "state.h"
+#include "supportmapping.h"
+#include "threadpool.h"
+#include "timelines.h"
+#include "timeofimpact.h"
+#include "unionfind.h"
 
 class DummyEngine {
   public:
     DummyEngine();
     DummyEngine(MotionEngine & motionengine,
                 std::vector<Object*> const & objects);
-    void randomEvent(int object_id);
+    // each object starts with the motion in its initial event
+    DummyEngine(MotionEngine & motionengine,
+                std::vector<Object*> const & objects,
+                std::vector<CollisionEvent> const & initial_events);
+    void randomEvent(int object_id, float start);
+    // Any time works. Times not simulated yet are simulated first, earlier
+    // ones are looked up in the timelines.
     void getState(int object_id, float time, State & state);
+    void getStates(float time, std::vector<State> & states);
+    void getPoses(float time, std::vector<glm::mat4> & poses);
+    // A collision is applied as a whole or not at all, so fewer than
+    // max_events may be applied even though some are left before time.
+    int processEvents(float time, int max_events);
+    float time() const;  // of the latest applied event
+    float nextTime() const;  // of the earliest pending event, FLT_MAX if none
     int numObjects() const;
     void pushEvent(CollisionEvent const & col);
+    // Takes the object out of the simulation until its next forced event.
+    // Objects that were predicted to hit it are predicted again.
+    void deactivate(int object_id);
+    // Sets each object's motion to its event as if that had been applied
+    // already, and predicts the objects again from start, for motion worked
+    // out somewhere else. An event before the latest one of its object drops
+    // the earlier times of the object.
+    void install(std::vector<CollisionEvent> const & events, float start);
+    CollisionEvent const & latestEvent(int object_id) const;
+    void setBroadPhase(BroadPhaseType type);
+    void setThreads(int threads);
+    // every applied event is appended to log, NULL to stop
+    void setEventLog(EventLog * log);
+    // Everything needed to carry on from the latest applied event. Times
+    // before it are not kept, so a restored engine cannot rewind past the
+    // checkpoint. Restoring needs the same objects the checkpoint was made
+    // with, which is checked against the shapes saved in it.
+    bool saveCheckpoint(char const * path) const;
+    bool restoreCheckpoint(char const * path);
   private:
+    struct Prediction {
+      CollisionEvent events[2];
+      int count;  // 1 for a re-check, 2 for a collision
+    };
+
+    static std::vector<CollisionEvent> headOnMotion(int num_objects);
+    void predict(int object_id, float start, int const * candidates, int num_candidates,
+                 Prediction & prediction) const;
+    void predictAll(float start);
+    ImpactResult firstContact(int object_a, int object_b, float start, float end,
+                              float & time, Contact & contact) const;
+    void schedule(Prediction const & prediction);
+    bool narrowPhase(int object_a, int object_b, float time, Contact & contact) const;
+    void refineContact(int object_a, int object_b, float time, Contact & contact) const;
+    bool approaching(int object_a, int object_b, float time, Contact const & contact) const;
+    void sweptBounds(int object_id, float duration, AABB & box) const;
+
     std::vector<CollisionEvent> last_events_; // make not a pointer
+    Timelines timelines_;  // so earlier times can be looked up again
+    PoseBatch posebatch_;  // copy of last_events_ for evaluating every pose at once
+    std::vector<glm::mat4> poses_;
     std::vector<Object*> const * objects_; // make reference not pointer
-    std::queue<CollisionEvent> event_queue_;
+    float time_;
+    EventQueue event_queue_;
+
+    std::shared_ptr<BroadPhase> broadphase_;
+    BroadPhaseType broadphase_type_;
+    float cell_size_;  // of the spatial hash
+    std::vector<float> radii_;  // distance from center to furthest vertex
+    std::vector<bool> started_;  // whether the object's first event was processed
+    Collision collision_;
+    BoxCollision boxcollision_;
+    ConvexCollision convexcollision_;
+    std::vector<SupportMapping> supports_;  // one per distinct shape
+    std::vector<int> support_index_;  // object id to its entry in supports_
+    TimeOfImpact timeofimpact_;
+    std::vector<int> candidates_;
+    CollisionEvent popped_[2];
+    std::vector<int> orphans_;  // objects whose predicted partner moved on
+
+    // Everything due at the same time is applied before predicting again.
+    // Objects that collided with each other form an island, and islands
+    // are predicted on the pool.
+    int threads_;
+    std::shared_ptr<ThreadPool> pool_;  // started on first use
+    UnionFind islands_;
+    std::vector<int> touched_;  // objects applied or orphaned in the batch
+    std::vector<int> candidate_offsets_;  // candidates of touched_[i] are
+    std::vector<int> candidate_ids_;      // candidate_ids_[candidate_offsets_[i]..]
+    std::vector<std::pair<int, int> > members_;  // (island, index into touched_)
+    std::vector<int> island_offsets_;
+    std::vector<Prediction> predictions_;  // one per entry of touched_
+
+    EventLog * event_log_;
 
     MotionEngine * motionengine_;
 };
@@ -0,0 +1,191 @@
+#include "eventlog.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "collisionevent.h"
+
+#define EVENTLOG_MAGIC "CDEVLOG"
+#define EVENTLOG_VERSION 1
+#define WRITE_BUFFER (1 << 20)
+
+static_assert(sizeof(EventLogHeader) == 32, "log header layout");
+static_assert(sizeof(EventRecord) == 64, "log record layout");
+static_assert(sizeof(QuantizedEventRecord) == 48, "quantized log record layout");
+
+static int16_t quantize(float value) {
+  return (int16_t)lroundf(std::max(-1.0f, std::min(value, 1.0f)) * 32767.0f);
+}
+
+static float dequantize(int16_t value) {
+  return value / 32767.0f;
+}
+
+static float signNotZero(float value) {
+  return (value < 0.0f) ? -1.0f : 1.0f;
+}
+
+// Projects the unit vector onto the octahedron |x| + |y| + |z| = 1 and
+// folds the lower half over the upper one, leaving two coordinates.
+static void packDirection(glm::vec3 const & direction, int16_t * packed) {
+  float length = fabs(direction.x) + fabs(direction.y) + fabs(direction.z);
+  if (length == 0.0f) {
+    packed[0] = 0;
+    packed[1] = 0;
+    return;
+  }
+  float x = direction.x / length;
+  float y = direction.y / length;
+  if (direction.z < 0.0f) {
+    float folded_x = (1.0f - fabs(y)) * signNotZero(x);
+    float folded_y = (1.0f - fabs(x)) * signNotZero(y);
+    x = folded_x;
+    y = folded_y;
+  }
+  packed[0] = quantize(x);
+  packed[1] = quantize(y);
+}
+
+static glm::vec3 unpackDirection(int16_t const * packed) {
+  float x = dequantize(packed[0]);
+  float y = dequantize(packed[1]);
+  float z = 1.0f - fabs(x) - fabs(y);
+  if (z < 0.0f) {
+    float unfolded_x = (1.0f - fabs(y)) * signNotZero(x);
+    float unfolded_y = (1.0f - fabs(x)) * signNotZero(y);
+    x = unfolded_x;
+    y = unfolded_y;
+  }
+  return glm::normalize(glm::vec3(x, y, z));
+}
+
+void packEvent(CollisionEvent const & event, EventRecord & record) {
+  glm::vec3 const & coordinates = *event.initial_coordinates();
+  glm::quat const & orientation = *event.initial_orientation();
+  glm::vec3 const & velocity = *event.velocity();
+  glm::vec3 const & axis = *event.axis_of_rotation();
+
+  record.object = event.object();
+  record.time = event.time();
+  for (int i = 0; i < 3; i++) {
+    record.initial_coordinates[i] = coordinates[i];
+    record.velocity[i] = velocity[i];
+    record.axis_of_rotation[i] = axis[i];
+  }
+  record.initial_orientation[0] = orientation.w;
+  record.initial_orientation[1] = orientation.x;
+  record.initial_orientation[2] = orientation.y;
+  record.initial_orientation[3] = orientation.z;
+  record.angular_velocity = event.angular_velocity();
+}
+
+void unpackEvent(EventRecord const & record, CollisionEvent & event) {
+  float const * c = record.initial_coordinates;
+  float const * q = record.initial_orientation;
+  float const * v = record.velocity;
+  float const * a = record.axis_of_rotation;
+  event.setValues(record.object,
+                  record.time,
+                  glm::vec3(c[0], c[1], c[2]),
+                  glm::quat(q[0], q[1], q[2], q[3]),
+                  glm::vec3(a[0], a[1], a[2]),
+                  glm::vec3(v[0], v[1], v[2]),
+                  record.angular_velocity);
+}
+
+void packEvent(CollisionEvent const & event, QuantizedEventRecord & record) {
+  glm::vec3 const & coordinates = *event.initial_coordinates();
+  glm::quat const & orientation = *event.initial_orientation();
+  glm::vec3 const & velocity = *event.velocity();
+
+  record.object = event.object();
+  record.time = event.time();
+  for (int i = 0; i < 3; i++) {
+    record.initial_coordinates[i] = coordinates[i];
+    record.velocity[i] = velocity[i];
+  }
+  record.initial_orientation[0] = quantize(orientation.w);
+  record.initial_orientation[1] = quantize(orientation.x);
+  record.initial_orientation[2] = quantize(orientation.y);
+  record.initial_orientation[3] = quantize(orientation.z);
+  packDirection(*event.axis_of_rotation(), record.axis_of_rotation);
+  record.angular_velocity = event.angular_velocity();
+}
+
+void unpackEvent(QuantizedEventRecord const & record, CollisionEvent & event) {
+  float const * c = record.initial_coordinates;
+  int16_t const * q = record.initial_orientation;
+  float const * v = record.velocity;
+  glm::quat orientation = glm::quat(dequantize(q[0]), dequantize(q[1]), dequantize(q[2]), dequantize(q[3]));
+  event.setValues(record.object,
+                  record.time,
+                  glm::vec3(c[0], c[1], c[2]),
+                  glm::normalize(orientation),
+                  unpackDirection(record.axis_of_rotation),
+                  glm::vec3(v[0], v[1], v[2]),
+                  record.angular_velocity);
+}
+
+EventLog::EventLog() {
+  file_ = NULL;
+  quantized_ = false;
+  size_ = 0;
+}
+
+EventLog::~EventLog() {
+  close();
+}
+
+bool EventLog::open(char const * path, int num_objects, bool quantized) {
+  close();
+  file_ = fopen(path, "wb");
+  if (file_ == NULL) {
+    perror(path);
+    return false;
+  }
+  setvbuf(file_, NULL, _IOFBF, WRITE_BUFFER);
+  quantized_ = quantized;
+  size_ = 0;
+
+  EventLogHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, EVENTLOG_MAGIC, sizeof(EVENTLOG_MAGIC));
+  header.version = EVENTLOG_VERSION;
+  header.record_size = quantized ? sizeof(QuantizedEventRecord) : sizeof(EventRecord);
+  header.num_objects = num_objects;
+  return fwrite(&header, sizeof(header), 1, file_) == 1;
+}
+
+void EventLog::append(CollisionEvent const & event) {
+  if (quantized_) {
+    QuantizedEventRecord record;
+    packEvent(event, record);
+    fwrite(&record, sizeof(record), 1, file_);
+  } else {
+    EventRecord record;
+    packEvent(event, record);
+    fwrite(&record, sizeof(record), 1, file_);
+  }
+  size_++;
+}
+
+bool EventLog::close() {
+  if (file_ == NULL) {
+    return true;
+  }
+  bool ok = !ferror(file_);
+  ok = (fclose(file_) == 0) && ok;
+  file_ = NULL;
+  return ok;
+}
+
+bool EventLog::isOpen() const {
+  return file_ != NULL;
+}
+
+long long EventLog::size() const {
+  return size_;
+}
@@ -0,0 +1,69 @@
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+#include <cstdint>
+#include <cstdio>
+#include "collisionevent.h"
+
+// Motion between events follows from the latest event of each object, so
+// the applied events are the whole history of a run. The log is a header
+// followed by one fixed size record per applied event, in the order they
+// were applied, which is also order of time.
+struct EventLogHeader {
+  char magic[8];  // "CDEVLOG" and a 0
+  uint32_t version;
+  uint32_t record_size;
+  uint32_t num_objects;
+  uint32_t reserved[3];
+};
+
+struct EventRecord {
+  int32_t object;
+  float time;
+  float initial_coordinates[3];
+  float initial_orientation[4];  // w, x, y, z
+  float velocity[3];
+  float axis_of_rotation[3];
+  float angular_velocity;
+};
+
+// Three quarters of the size, for logs that get long. The orientation is
+// stored to about 1e-4 and the axis of rotation to about 1e-4 rad, the
+// rest as it is.
+struct QuantizedEventRecord {
+  int32_t object;
+  float time;
+  float initial_coordinates[3];
+  float velocity[3];
+  int16_t initial_orientation[4];  // w, x, y, z, scaled by 32767
+  int16_t axis_of_rotation[2];     // octahedral, scaled by 32767
+  float angular_velocity;
+};
+
+void packEvent(CollisionEvent const & event, EventRecord & record);
+void unpackEvent(EventRecord const & record, CollisionEvent & event);
+void packEvent(CollisionEvent const & event, QuantizedEventRecord & record);
+void unpackEvent(QuantizedEventRecord const & record, CollisionEvent & event);
+
+// Appends events to a log file. Records go through a stdio buffer, so a
+// crash loses at most the last few, and a cut off record at the end is
+// ignored by the reader.
+class EventLog {
+  public:
+    EventLog();
+    ~EventLog();
+
+    // quantized writes QuantizedEventRecords instead of EventRecords
+    bool open(char const * path, int num_objects, bool quantized);
+    void append(CollisionEvent const & event);
+    bool close();
+
+    bool isOpen() const;
+    long long size() const;  // records appended so far
+
+  private:
+    FILE * file_;
+    bool quantized_;
+    long long size_;
+};
+
+#endif
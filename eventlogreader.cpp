@@ -0,0 +1,165 @@
+#include "eventlogreader.h"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <glm/glm.hpp>
+#include "collisionevent.h"
+#include "eventlog.h"
+#include "motionengine.h"
+
+EventLogReader::EventLogReader() {
+  mapping_ = NULL;
+  mapping_size_ = 0;
+  records_ = NULL;
+  record_size_ = 0;
+  quantized_ = false;
+  size_ = 0;
+  num_objects_ = 0;
+}
+
+EventLogReader::~EventLogReader() {
+  close();
+}
+
+bool EventLogReader::open(char const * path) {
+  close();
+
+  int fd = ::open(path, O_RDONLY);
+  if (fd == -1) {
+    perror(path);
+    return false;
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0 || status.st_size < (off_t)sizeof(EventLogHeader)) {
+    fprintf(stderr, "%s: not an event log\n", path);
+    ::close(fd);
+    return false;
+  }
+  void * mapping = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    perror(path);
+    return false;
+  }
+  mapping_ = mapping;
+  mapping_size_ = status.st_size;
+
+  EventLogHeader const * header = (EventLogHeader const *)mapping_;
+  if (strncmp(header->magic, "CDEVLOG", sizeof(header->magic)) != 0 ||
+      (header->record_size != sizeof(EventRecord) &&
+       header->record_size != sizeof(QuantizedEventRecord))) {
+    fprintf(stderr, "%s: not an event log this version can read\n", path);
+    close();
+    return false;
+  }
+  num_objects_ = header->num_objects;
+  records_ = (char const *)(header + 1);
+  record_size_ = header->record_size;
+  quantized_ = (record_size_ == sizeof(QuantizedEventRecord));
+  // a record cut off by a crash is left out
+  size_ = (mapping_size_ - sizeof(EventLogHeader)) / record_size_;
+  madvise(mapping_, mapping_size_, MADV_SEQUENTIAL);
+
+  // counting sort of the record indices by object, keeping them in order
+  offsets_.assign(num_objects_ + 1, 0);
+  for (long long k = 0; k < size_; k++) {
+    int object = recordObject(k);
+    if (object >= 0 && object < num_objects_) {
+      offsets_[object + 1]++;
+    }
+  }
+  for (int i = 0; i < num_objects_; i++) {
+    offsets_[i + 1] += offsets_[i];
+  }
+  indices_.resize(offsets_[num_objects_]);
+  std::vector<long long> next(offsets_.begin(), offsets_.end() - 1);
+  for (long long k = 0; k < size_; k++) {
+    int object = recordObject(k);
+    if (object >= 0 && object < num_objects_) {
+      indices_[next[object]++] = k;
+    }
+  }
+  madvise(mapping_, mapping_size_, MADV_RANDOM);
+  return true;
+}
+
+void EventLogReader::close() {
+  if (mapping_ != NULL) {
+    munmap(mapping_, mapping_size_);
+  }
+  mapping_ = NULL;
+  mapping_size_ = 0;
+  records_ = NULL;
+  record_size_ = 0;
+  quantized_ = false;
+  size_ = 0;
+  num_objects_ = 0;
+  offsets_.clear();
+  indices_.clear();
+}
+
+int EventLogReader::numObjects() const {
+  return num_objects_;
+}
+
+long long EventLogReader::size() const {
+  return size_;
+}
+
+float EventLogReader::endTime() const {
+  return (size_ > 0) ? recordTime(size_ - 1) : 0.0f;
+}
+
+bool EventLogReader::eventAt(int object_id, float time, CollisionEvent & event) const {
+  if (object_id < 0 || object_id >= num_objects_) {
+    return false;
+  }
+
+  // first event after time, the one before it is the answer
+  long long low = offsets_[object_id];
+  long long high = offsets_[object_id + 1];
+  long long first = low;
+  while (low < high) {
+    long long middle = low + (high - low) / 2;
+    if (recordTime(indices_[middle]) <= time) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low == first) {
+    return false;
+  }
+  char const * record = records_ + indices_[low - 1] * record_size_;
+  if (quantized_) {
+    unpackEvent(*(QuantizedEventRecord const *)record, event);
+  } else {
+    unpackEvent(*(EventRecord const *)record, event);
+  }
+  return true;
+}
+
+int EventLogReader::recordObject(long long k) const {
+  return ((EventRecord const *)(records_ + k * record_size_))->object;
+}
+
+float EventLogReader::recordTime(long long k) const {
+  return ((EventRecord const *)(records_ + k * record_size_))->time;
+}
+
+void EventLogReader::getPoses(float time, MotionEngine & motionengine, std::vector<glm::mat4> & poses) const {
+  poses.resize(num_objects_);
+  CollisionEvent event;
+  for (int i = 0; i < num_objects_; i++) {
+    if (eventAt(i, time, event)) {
+      motionengine.pose(event, time, poses[i]);
+    } else {
+      poses[i] = glm::mat4(1.0f);
+    }
+  }
+}
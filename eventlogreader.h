@@ -0,0 +1,49 @@
+#ifndef EVENTLOGREADER_H
+#define EVENTLOGREADER_H
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "collisionevent.h"
+#include "eventlog.h"
+#include "motionengine.h"
+
+// Maps an event log into memory and finds the state of any object at any
+// time without simulating anything. Opening makes one pass over the
+// records to list each object's events, after which a lookup is a binary
+// search over the events of that object. Either kind of record works.
+class EventLogReader {
+  public:
+    EventLogReader();
+    ~EventLogReader();
+
+    bool open(char const * path);
+    void close();
+
+    int numObjects() const;
+    long long size() const;  // records
+    float endTime() const;   // of the last record
+
+    // Latest event of the object at or before time. False if the object
+    // has none that early.
+    bool eventAt(int object_id, float time, CollisionEvent & event) const;
+    // objects without an event yet stay at the origin
+    void getPoses(float time, MotionEngine & motionengine, std::vector<glm::mat4> & poses) const;
+
+  private:
+    // both kinds of record start with these
+    int recordObject(long long k) const;
+    float recordTime(long long k) const;
+
+    void * mapping_;
+    size_t mapping_size_;
+    char const * records_;
+    size_t record_size_;
+    bool quantized_;
+    long long size_;
+    int num_objects_;
+
+    std::vector<long long> offsets_;  // events of object i are records_[indices_[k]]
+    std::vector<long long> indices_;  // for k in offsets_[i]..offsets_[i + 1]
+};
+
+#endif
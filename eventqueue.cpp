@@ -0,0 +1,155 @@
+#include "eventqueue.h"
+#include <algorithm>
+#include <vector>
+#include "checkpoint.h"
+#include "collisionevent.h"
+
+using namespace std;
+
+EventQueue::EventQueue() {
+  sequence_ = 0;
+}
+
+// Every object always has something pending, so the heap is at least that
+// big and there is no point in growing it there one doubling at a time.
+void EventQueue::resize(int num_objects) {
+  generations_.resize(num_objects, 0);
+  heap_.reserve(num_objects);
+  entries_.reserve(num_objects);
+}
+
+void EventQueue::force(CollisionEvent const & event) {
+  Entry entry;
+  entry.events[0] = event;
+  entry.generations[0] = -1;
+  entry.count = 1;
+  push(entry);
+}
+
+void EventQueue::schedule(CollisionEvent const & event) {
+  Entry entry;
+  entry.events[0] = event;
+  entry.generations[0] = generations_[event.object()];
+  entry.count = 1;
+  push(entry);
+}
+
+void EventQueue::schedule(CollisionEvent const & event_a, CollisionEvent const & event_b) {
+  Entry entry;
+  entry.events[0] = event_a;
+  entry.events[1] = event_b;
+  entry.generations[0] = generations_[event_a.object()];
+  entry.generations[1] = generations_[event_b.object()];
+  entry.count = 2;
+  push(entry);
+}
+
+void EventQueue::invalidate(int object) {
+  generations_[object]++;
+}
+
+bool EventQueue::empty() const {
+  return heap_.empty();
+}
+
+int EventQueue::size() const {
+  return heap_.size();
+}
+
+float EventQueue::time() const {
+  return heap_.front().time;
+}
+
+int EventQueue::count() const {
+  return entries_[heap_.front().entry].count;
+}
+
+int EventQueue::pop(CollisionEvent * events, vector<int> & orphans) {
+  pop_heap(heap_.begin(), heap_.end(), later);
+  int index = heap_.back().entry;
+  heap_.pop_back();
+  free_entries_.push_back(index);
+  Entry const & entry = entries_[index];
+
+  bool stale = false;
+  for (int k = 0; k < entry.count; k++) {
+    int generation = entry.generations[k];
+    if (generation != -1 && generation != generations_[entry.events[k].object()]) {
+      stale = true;
+    }
+  }
+
+  if (stale) {
+    for (int k = 0; k < entry.count; k++) {
+      if (entry.generations[k] == generations_[entry.events[k].object()]) {
+        orphans.push_back(entry.events[k].object());
+      }
+    }
+    return 0;
+  }
+
+  for (int k = 0; k < entry.count; k++) {
+    generations_[entry.events[k].object()]++;
+    events[k] = entry.events[k];
+  }
+  return entry.count;
+}
+
+// The entries go in heap order, the same as when the heap held them.
+void EventQueue::save(CheckpointWriter & writer) const {
+  vector<Entry> entries(heap_.size());
+  for (int k = 0; k < heap_.size(); k++) {
+    entries[k] = entries_[heap_[k].entry];
+  }
+  writer.write(entries.data(), entries.size() * sizeof(Entry));
+  writer.write(generations_.data(), generations_.size() * sizeof(int));
+  writer.write(&sequence_, sizeof(sequence_));
+}
+
+bool EventQueue::restore(CheckpointReader & reader) {
+  size_t heap_size, generations_size, sequence_size;
+  Entry const * heap = (Entry const *)reader.read(heap_size);
+  int const * generations = (int const *)reader.read(generations_size);
+  long long const * sequence = (long long const *)reader.read(sequence_size);
+  if (heap == NULL || heap_size % sizeof(Entry) != 0 ||
+      generations == NULL || generations_size != generations_.size() * sizeof(int) ||
+      sequence == NULL || sequence_size != sizeof(sequence_)) {
+    return false;
+  }
+
+  // still a heap, as it was saved in heap order
+  int n = heap_size / sizeof(Entry);
+  entries_.assign(heap, heap + n);
+  free_entries_.clear();
+  heap_.resize(n);
+  for (int k = 0; k < n; k++) {
+    Key key = { entries_[k].events[0].time(), k, entries_[k].sequence };
+    heap_[k] = key;
+  }
+  generations_.assign(generations, generations + generations_.size());
+  sequence_ = *sequence;
+  return true;
+}
+
+// std heaps keep the largest element on top, so order them the other way
+bool EventQueue::later(Key const & a, Key const & b) {
+  if (a.time != b.time) {
+    return a.time > b.time;
+  }
+  return a.sequence > b.sequence;
+}
+
+void EventQueue::push(Entry & entry) {
+  entry.sequence = sequence_++;
+  int index = entries_.size();
+  if (free_entries_.empty()) {
+    entries_.push_back(entry);
+  } else {
+    index = free_entries_.back();
+    free_entries_.pop_back();
+    entries_[index] = entry;
+  }
+  Key key = { entry.events[0].time(), index, entry.sequence };
+  heap_.push_back(key);
+  push_heap(heap_.begin(), heap_.end(), later);
+}
@@ -0,0 +1,69 @@
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+#include <vector>
+#include "checkpoint.h"
+#include "collisionevent.h"
+
+// Min-heap of pending events ordered by time. Every object has a generation
+// that goes up whenever one of its events is applied. A prediction remembers
+// the generations of the objects it involves and is dropped when popped if
+// any of them has moved on since, rather than being searched for and
+// removed when the motion changes.
+//
+// The heap itself only holds a small key per entry, and the entries stay
+// where they were put until popped, so sifting moves 16 bytes at a time
+// rather than two whole events.
+class EventQueue {
+  public:
+    EventQueue();
+
+    void resize(int num_objects);
+
+    // applied no matter what happened to the object in the meantime
+    void force(CollisionEvent const & event);
+    // stale once the object's motion changes
+    void schedule(CollisionEvent const & event);
+    // both halves of a collision, stale once either object's motion changes
+    void schedule(CollisionEvent const & event_a, CollisionEvent const & event_b);
+    // makes what is scheduled for the object stale, as if its motion changed
+    void invalidate(int object);
+
+    bool empty() const;
+    int size() const;
+    float time() const;
+    int count() const;  // events in the earliest entry, stale or not
+
+    // Removes the earliest entry and returns how many of its events should
+    // be applied. A stale entry returns 0 and lists the objects in it that
+    // are still current, which have lost their prediction.
+    int pop(CollisionEvent * events, std::vector<int> & orphans);
+
+    // the entries still pending and the generations, as they are in memory
+    void save(CheckpointWriter & writer) const;
+    // false, leaving the queue as it was, if the blocks do not fit it
+    bool restore(CheckpointReader & reader);
+
+  private:
+    struct Entry {
+      CollisionEvent events[2];
+      int generations[2];  // -1 when forced
+      int count;
+      long long sequence;  // keeps events at the same time in push order
+    };
+    struct Key {
+      float time;  // of events[0]
+      int entry;   // index into entries_
+      long long sequence;
+    };
+
+    static bool later(Key const & a, Key const & b);
+    void push(Entry & entry);
+
+    std::vector<Key> heap_;
+    std::vector<Entry> entries_;
+    std::vector<int> free_entries_;  // popped, so they can be reused
+    std::vector<int> generations_;
+    long long sequence_;
+};
+
+#endif
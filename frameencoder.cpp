@@ -0,0 +1,179 @@
+#include "frameencoder.h"
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <png.h>
+
+using namespace std;
+
+FrameEncoder::FrameEncoder() {
+  raw_ = NULL;
+  width_ = 0;
+  height_ = 0;
+  frames_ = 0;
+  current_ = -1;
+  closing_ = false;
+  failed_ = false;
+}
+
+FrameEncoder::~FrameEncoder() {
+  close();
+}
+
+bool FrameEncoder::open(Format format, char const * path, int width, int height) {
+  close();
+
+  format_ = format;
+  path_ = path;
+  width_ = width;
+  height_ = height;
+  frames_ = 0;
+  closing_ = false;
+  failed_ = false;
+
+  if (format == RAW_VIDEO) {
+    raw_ = fopen(path, "wb");
+    if (raw_ == NULL) {
+      perror(path);
+      return false;
+    }
+  }
+
+  buffers_.assign(BUFFERS, vector<unsigned char>(width * height * 4));
+  free_.clear();
+  queued_.clear();
+  for (int i = 0; i < BUFFERS; i++) {
+    free_.push_back(i);
+  }
+  current_ = -1;
+
+  thread_ = thread(&FrameEncoder::run, this);
+  return true;
+}
+
+bool FrameEncoder::close() {
+  if (thread_.joinable()) {
+    {
+      lock_guard<mutex> lock(mutex_);
+      closing_ = true;
+    }
+    changed_.notify_all();
+    thread_.join();
+  }
+  if (raw_ != NULL) {
+    if (fclose(raw_) != 0) {
+      failed_ = true;
+    }
+    raw_ = NULL;
+  }
+  return !failed_;
+}
+
+unsigned char * FrameEncoder::buffer() {
+  if (current_ == -1) {
+    unique_lock<mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return !free_.empty(); });
+    current_ = free_.front();
+    free_.pop_front();
+  }
+  return &buffers_[current_][0];
+}
+
+void FrameEncoder::submit() {
+  buffer();
+  {
+    lock_guard<mutex> lock(mutex_);
+    queued_.push_back(current_);
+  }
+  changed_.notify_all();
+  current_ = -1;
+  frames_++;
+}
+
+int FrameEncoder::frames() const {
+  return frames_;
+}
+
+// Frames are written in the order they were submitted, so the frame number
+// is simply a count.
+void FrameEncoder::run() {
+  int index = 0;
+  while (true) {
+    int next;
+    {
+      unique_lock<mutex> lock(mutex_);
+      changed_.wait(lock, [this] { return closing_ || !queued_.empty(); });
+      if (queued_.empty()) {
+        return;
+      }
+      next = queued_.front();
+      queued_.pop_front();
+    }
+
+    // after the first failure the rest would most likely fail the same way
+    if (!failed_ && !write(buffers_[next], index)) {
+      failed_ = true;
+    }
+    index++;
+
+    {
+      lock_guard<mutex> lock(mutex_);
+      free_.push_back(next);
+    }
+    changed_.notify_all();
+  }
+}
+
+bool FrameEncoder::write(vector<unsigned char> const & pixels, int index) {
+  int stride = width_ * 4;
+  if (format_ == RAW_VIDEO) {
+    for (int y = height_ - 1; y >= 0; y--) {
+      if (fwrite(&pixels[y * stride], 1, stride, raw_) != (size_t)stride) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  char filename[32];
+  snprintf(filename, sizeof(filename), "/frame%06d.png", index);
+  return writePng(pixels, (path_ + filename).c_str());
+}
+
+bool FrameEncoder::writePng(vector<unsigned char> const & pixels, char const * filename) {
+  FILE * file = fopen(filename, "wb");
+  if (file == NULL) {
+    perror(filename);
+    return false;
+  }
+
+  vector<png_bytep> rows(height_);
+  for (int y = 0; y < height_; y++) {
+    rows[y] = (png_bytep)&pixels[(height_ - 1 - y) * width_ * 4];
+  }
+
+  png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+  png_infop info = png_create_info_struct(png);
+  if (setjmp(png_jmpbuf(png))) {
+    png_destroy_write_struct(&png, &info);
+    fclose(file);
+    return false;
+  }
+
+  png_init_io(png, file);
+  // wireframes on a flat background compress well enough without trying
+  png_set_compression_level(png, 1);
+  png_set_filter(png, 0, PNG_FILTER_NONE);
+  png_set_IHDR(png, info, width_, height_, 8, PNG_COLOR_TYPE_RGBA, PNG_INTERLACE_NONE,
+               PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+  png_write_info(png, info);
+  png_write_image(png, &rows[0]);
+  png_write_end(png, NULL);
+  png_destroy_write_struct(&png, &info);
+
+  return fclose(file) == 0;
+}
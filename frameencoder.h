@@ -0,0 +1,64 @@
+#ifndef FRAMEENCODER_H
+#define FRAMEENCODER_H
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Writes rendered frames out on a thread of its own, either as numbered
+// PNG files or appended to one file of raw RGBA frames. Frames come in
+// bottom row first, the way glReadPixels returns them, and are written
+// top row first. A fixed number of frame buffers go around between the
+// two threads, and the render side only waits once all of them are still
+// waiting to be written.
+class FrameEncoder {
+  public:
+    enum Format {
+      PNG_SEQUENCE,  // path is a directory
+      RAW_VIDEO      // path is a file
+    };
+
+    FrameEncoder();
+    ~FrameEncoder();
+
+    bool open(Format format, char const * path, int width, int height);
+    // Finishes writing everything submitted so far. Returns false if
+    // anything could not be written.
+    bool close();
+
+    // width * height * 4 bytes to render the next frame into
+    unsigned char * buffer();
+    void submit();
+
+    int frames() const;  // submitted so far
+
+  private:
+    const static int BUFFERS = 8;
+
+    void run();
+    bool write(std::vector<unsigned char> const & pixels, int index);
+    bool writePng(std::vector<unsigned char> const & pixels, char const * filename);
+
+    Format format_;
+    std::string path_;
+    FILE * raw_;
+    int width_;
+    int height_;
+    int frames_;
+
+    std::vector<std::vector<unsigned char> > buffers_;
+    int current_;  // buffer being rendered into, -1 if none yet
+    std::deque<int> free_;
+    std::deque<int> queued_;
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    bool closing_;
+    bool failed_;
+};
+
+#endif
@@ -0,0 +1,118 @@
+#include "headless.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <glm/glm.hpp>
+#include "dummyengine.h"
+#include "profiler.h"
+
+using namespace std;
+
+Headless::Headless() { }
+
+Headless::Headless(DummyEngine & dummyengine) {
+  dummyengine_ = &dummyengine;
+  dump_ = NULL;
+  interval_ = 0.0f;
+  checkpoint_path_ = NULL;
+  checkpoint_interval_ = 0.0f;
+}
+
+void Headless::setDump(FILE * file, float interval) {
+  dump_ = file;
+  interval_ = interval;
+}
+
+void Headless::setCheckpoint(char const * path, float interval) {
+  checkpoint_path_ = path;
+  checkpoint_interval_ = interval;
+}
+
+void Headless::run(float time, int max_events) {
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+#ifdef PROFILE
+  Stats before;
+  Profiler::shared().stats(before);
+#endif
+
+  int applied = 0;
+  float now = dummyengine_->time();
+  float next_dump = (interval_ > 0.0f) ? 0.0f : time;
+  float last_dump = -1.0f;
+  float next_checkpoint = (checkpoint_interval_ > 0.0f) ? checkpoint_interval_ : time;
+  // the same steps as a run that went all the way from 0
+  while (interval_ > 0.0f && next_dump < now) {
+    next_dump += interval_;
+  }
+  while (checkpoint_interval_ > 0.0f && next_checkpoint <= now) {
+    next_checkpoint += checkpoint_interval_;
+  }
+
+  while (now < time && applied < max_events) {
+    float target = min(time, min(next_dump, next_checkpoint));
+    applied += dummyengine_->processEvents(target, max_events - applied);
+    if (dummyengine_->nextTime() < target) {
+      // stopped on the event count, somewhere before target
+      now = dummyengine_->time();
+      break;
+    }
+
+    now = target;
+    if (interval_ > 0.0f && now == next_dump) {
+      dumpPoses(now);
+      last_dump = now;
+      next_dump += interval_;
+    }
+    if (checkpoint_interval_ > 0.0f && now == next_checkpoint) {
+      saveCheckpoint();
+      next_checkpoint += checkpoint_interval_;
+    }
+  }
+
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  if (now != last_dump) {
+    dumpPoses(now);
+  }
+  saveCheckpoint();
+
+  printf("%d events up to time %g in %.3f s", applied, now, elapsed.count());
+  if (elapsed.count() > 0.0) {
+    printf(" (%.0f events/s)", applied / elapsed.count());
+  }
+#ifdef PROFILE
+  Stats after;
+  Profiler::shared().stats(after);
+  printf(", %lld heap allocations",
+         after.counters[COUNTER_ALLOCATIONS] - before.counters[COUNTER_ALLOCATIONS]);
+#endif
+  printf("\n");
+}
+
+void Headless::dumpPoses(float time) {
+  if (dump_ == NULL) {
+    return;
+  }
+
+  dummyengine_->getPoses(time, poses_);
+  writePoses(dump_, time, poses_);
+}
+
+void Headless::saveCheckpoint() {
+  if (checkpoint_path_ != NULL) {
+    dummyengine_->saveCheckpoint(checkpoint_path_);
+  }
+}
+
+void Headless::writePoses(FILE * file, float time, vector<glm::mat4> const & poses) {
+  for (int i = 0; i < poses.size(); i++) {
+    glm::mat4 const & pose = poses[i];
+    fprintf(file, "%g %d", time, i);
+    for (int column = 0; column < 4; column++) {
+      for (int row = 0; row < 4; row++) {
+        fprintf(file, " %g", pose[column][row]);
+      }
+    }
+    fprintf(file, "\n");
+  }
+}
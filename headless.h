@@ -0,0 +1,43 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+#include <cstdio>
+#include <vector>
+#include <glm/glm.hpp>
+#include "dummyengine.h"
+
+// Advances the engine as fast as it can instead of once per frame, for
+// running simulations without a display.
+class Headless {
+  public:
+    Headless();
+    Headless(DummyEngine & dummyengine);
+
+    // poses are written every interval of simulated time, or only at the
+    // end if interval is 0
+    void setDump(FILE * file, float interval);
+    // a checkpoint is saved to path every interval of simulated time and
+    // at the end, or only at the end if interval is 0
+    void setCheckpoint(char const * path, float interval);
+
+    // Runs until time or until max_events events have been applied,
+    // whichever comes first, then prints how fast it went. Carries on from
+    // wherever the engine is, which is after 0 when it was restored.
+    void run(float time, int max_events);
+
+    // one line per object: time, object id and the 16 entries of its pose
+    // in column major order
+    static void writePoses(FILE * file, float time, std::vector<glm::mat4> const & poses);
+
+  private:
+    void dumpPoses(float time);
+    void saveCheckpoint();
+
+    DummyEngine * dummyengine_;
+    FILE * dump_;
+    float interval_;
+    char const * checkpoint_path_;
+    float checkpoint_interval_;
+    std::vector<glm::mat4> poses_;
+};
+
+#endif
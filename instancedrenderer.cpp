@@ -0,0 +1,200 @@
+#define GL_GLEXT_PROTOTYPES
+#include "instancedrenderer.h"
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "object.h"
+#include "shape.h"
+
+#define SYNC_TIMEOUT 1000000000  // ns
+
+// Colored by position like the client array path, and uses the fixed
+// function matrices so the viewer's camera code stays as it is.
+static const char * VERTEX_SHADER =
+  "#version 330 compatibility\n"
+  "layout(location = 0) in vec4 position;\n"
+  "layout(location = 1) in mat4 pose;\n"
+  "out vec4 color;\n"
+  "void main() {\n"
+  "  color = clamp(position, 0.0, 1.0);\n"
+  "  gl_Position = gl_ModelViewProjectionMatrix * pose * position;\n"
+  "}\n";
+
+static const char * FRAGMENT_SHADER =
+  "#version 330 compatibility\n"
+  "in vec4 color;\n"
+  "out vec4 fragment;\n"
+  "void main() {\n"
+  "  fragment = color;\n"
+  "}\n";
+
+InstancedRenderer::InstancedRenderer() {
+  program_ = 0;
+  instances_ = 0;
+  mapped_ = NULL;
+  region_ = 0;
+  for (int i = 0; i < REGIONS; i++) {
+    fences_[i] = 0;
+  }
+}
+
+#ifdef __APPLE__
+
+// the legacy contexts GLUT gives us there stop at OpenGL 2.1
+bool InstancedRenderer::init(std::vector<Object*> const & objects) {
+  return false;
+}
+
+void InstancedRenderer::draw(std::vector<glm::mat4> const & poses) { }
+
+bool InstancedRenderer::buildProgram() {
+  return false;
+}
+
+#else
+
+bool InstancedRenderer::init(std::vector<Object*> const & objects) {
+  GLint major = 0, minor = 0;
+  glGetIntegerv(GL_MAJOR_VERSION, &major);
+  glGetIntegerv(GL_MINOR_VERSION, &minor);
+  if (major < 4 || (major == 4 && minor < 4) || objects.empty()) {
+    return false;
+  }
+  if (!buildProgram()) {
+    return false;
+  }
+
+  // objects with the same shape get consecutive instances
+  std::map<Shape const *, std::vector<int> > by_shape;
+  for (int i = 0; i < objects.size(); i++) {
+    by_shape[objects[i]->shape()].push_back(i);
+  }
+
+  int num_objects = objects.size();
+  GLsizeiptr region_size = num_objects * sizeof(glm::mat4);
+  glGenBuffers(1, &instances_);
+  glBindBuffer(GL_ARRAY_BUFFER, instances_);
+  GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  glBufferStorage(GL_ARRAY_BUFFER, REGIONS * region_size, NULL, flags);
+  mapped_ = (glm::mat4 *)glMapBufferRange(GL_ARRAY_BUFFER, 0, REGIONS * region_size, flags);
+  if (mapped_ == NULL) {
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDeleteBuffers(1, &instances_);
+    glDeleteProgram(program_);
+    instances_ = 0;
+    program_ = 0;
+    return false;
+  }
+
+  slots_.resize(num_objects);
+  int first = 0;
+  for (std::map<Shape const *, std::vector<int> >::iterator it = by_shape.begin();
+       it != by_shape.end(); ++it) {
+    std::vector<int> const & ids = it->second;
+    Object const * object = objects[ids[0]];
+
+    Batch batch;
+    batch.num_indices = 3 * object->numtris();
+    batch.first = first;
+    batch.count = ids.size();
+    for (int k = 0; k < ids.size(); k++) {
+      slots_[ids[k]] = first + k;
+    }
+    first += ids.size();
+
+    glGenVertexArrays(1, &batch.vertex_array);
+    glBindVertexArray(batch.vertex_array);
+
+    glGenBuffers(1, &batch.vertices);
+    glBindBuffer(GL_ARRAY_BUFFER, batch.vertices);
+    glBufferData(GL_ARRAY_BUFFER, object->numverts() * sizeof(glm::vec4), object->verts(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, 0);
+
+    glGenBuffers(1, &batch.indices);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.indices);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, object->numtris() * sizeof(glm::highp_uvec3), object->tris(), GL_STATIC_DRAW);
+
+    // a mat4 attribute takes up four locations, one per column
+    glBindBuffer(GL_ARRAY_BUFFER, instances_);
+    for (int column = 0; column < 4; column++) {
+      glEnableVertexAttribArray(1 + column);
+      glVertexAttribPointer(1 + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                            (void *)(column * sizeof(glm::vec4)));
+      glVertexAttribDivisor(1 + column, 1);
+    }
+
+    batches_.push_back(batch);
+  }
+
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  return true;
+}
+
+void InstancedRenderer::draw(std::vector<glm::mat4> const & poses) {
+  if (fences_[region_] != 0) {
+    glClientWaitSync(fences_[region_], GL_SYNC_FLUSH_COMMANDS_BIT, SYNC_TIMEOUT);
+    glDeleteSync(fences_[region_]);
+    fences_[region_] = 0;
+  }
+
+  int num_objects = slots_.size();
+  glm::mat4 * region = mapped_ + region_ * num_objects;
+  for (int i = 0; i < poses.size() && i < num_objects; i++) {
+    region[slots_[i]] = poses[i];
+  }
+
+  glUseProgram(program_);
+  for (int i = 0; i < batches_.size(); i++) {
+    Batch const & batch = batches_[i];
+    glBindVertexArray(batch.vertex_array);
+    glDrawElementsInstancedBaseInstance(GL_TRIANGLES, batch.num_indices, GL_UNSIGNED_INT, 0,
+                                        batch.count, region_ * num_objects + batch.first);
+  }
+  glBindVertexArray(0);
+  glUseProgram(0);
+
+  fences_[region_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  region_ = (region_ + 1) % REGIONS;
+}
+
+bool InstancedRenderer::buildProgram() {
+  char const * sources[2] = { VERTEX_SHADER, FRAGMENT_SHADER };
+  GLenum types[2] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER };
+
+  program_ = glCreateProgram();
+  for (int i = 0; i < 2; i++) {
+    GLuint shader = glCreateShader(types[i]);
+    glShaderSource(shader, 1, &sources[i], NULL);
+    glCompileShader(shader);
+
+    GLint compiled;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+      char log[1024];
+      glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+      fprintf(stderr, "instanced rendering unavailable: %s\n", log);
+      glDeleteShader(shader);
+      glDeleteProgram(program_);
+      program_ = 0;
+      return false;
+    }
+    glAttachShader(program_, shader);
+    glDeleteShader(shader);
+  }
+
+  glLinkProgram(program_);
+  GLint linked;
+  glGetProgramiv(program_, GL_LINK_STATUS, &linked);
+  if (!linked) {
+    glDeleteProgram(program_);
+    program_ = 0;
+    return false;
+  }
+  return true;
+}
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef INSTANCEDRENDERER_H
+#define INSTANCEDRENDERER_H
+#include <vector>
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+#include <glm/glm.hpp>
+#include "object.h"
+
+// Draws every object with one instanced draw call per shape. The vertices
+// and triangles of each shape are uploaded once, and the poses are copied
+// straight into a persistently mapped buffer split in three regions, so a
+// frame can be written while the GPU may still be reading the last two.
+// Needs OpenGL 4.4 for the persistent mapping, which llvmpipe has.
+class InstancedRenderer {
+  public:
+    InstancedRenderer();
+
+    // False when the context can not do it, and nothing was created then.
+    bool init(std::vector<Object*> const & objects);
+    // poses in object order, drawn with the current modelview and projection
+    void draw(std::vector<glm::mat4> const & poses);
+
+  private:
+    const static int REGIONS = 3;
+
+    struct Batch {
+      GLuint vertex_array;
+      GLuint vertices;
+      GLuint indices;
+      GLsizei num_indices;
+      int first;  // instance of the first object with the shape
+      int count;
+    };
+
+    bool buildProgram();
+
+    std::vector<Batch> batches_;
+    std::vector<int> slots_;  // object id to its instance within a region
+    GLuint program_;
+    GLuint instances_;
+    glm::mat4 * mapped_;
+    GLsync fences_[REGIONS];  // set once the GPU is done with a region
+    int region_;
+};
+
+#endif
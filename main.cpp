@@ -1,20 +1,225 @@
+#include <cfloat>
+#include <climits>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <vector>
-#define GL_GLEXT_PROTOTYPES
-#ifdef __APPLE__
-#include <GLUT/glut.h>
-#else
-#include <GL/glut.h>
-#endif
 #include <glm/glm.hpp>
-#include <glm/gtx/transform.hpp>
+#include "broadphase.h"
 #include "object.h"
 #include "cuboid.h"
-#include "viewer.h"
+#include "eventlogreader.h"
+#include "frameencoder.h"
+#include "headless.h"
+#include "motionengine.h"
+#include "profiler.h"
+#include "region.h"
+#include "replay.h"
+#include "scene.h"
 #include "simulation.h"
 
+#define TRACE_EVENTS 1000000  // about 50 MB of trace
+
+static char const * stats_path = NULL;
+static char const * trace_path = NULL;
+
+// The viewer leaves through exit(), so this runs from atexit.
+static void writeProfile() {
+  if (stats_path != NULL) {
+    FILE * file = fopen(stats_path, "w");
+    if (file == NULL || !Profiler::shared().writeStats(file)) {
+      perror(stats_path);
+    }
+    if (file != NULL) {
+      fclose(file);
+    }
+  }
+  if (trace_path != NULL) {
+    FILE * file = fopen(trace_path, "w");
+    if (file == NULL || !Profiler::shared().writeTrace(file)) {
+      perror(trace_path);
+    }
+    if (file != NULL) {
+      fclose(file);
+    }
+  }
+}
+
 int main(int argc, char * argv[]) {
-  Simulation sim = Simulation();
+  BroadPhaseType broadphase = AABB_TREE;
+  bool headless = false;
+  float until = FLT_MAX;
+  int max_events = INT_MAX;
+  char const * dump_path = NULL;
+  float dump_interval = 0.0f;
+  int threads = 0;  // every core
+  char const * export_path = NULL;
+  FrameEncoder::Format export_format = FrameEncoder::PNG_SEQUENCE;
+  int width = 1000;
+  int height = 800;
+  char const * log_path = NULL;
+  bool quantized_log = false;
+  char const * replay_path = NULL;
+  char const * scene_path = NULL;
+  char const * save_scene_path = NULL;
+  char const * checkpoint_path = NULL;
+  float checkpoint_interval = 0.0f;
+  char const * resume_path = NULL;
+  int regions = 1;
+  float window = 0.1f;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--broadphase") == 0 && i + 1 < argc) {
+      i++;
+      if (strcmp(argv[i], "sap") == 0) {
+        broadphase = SWEEP_AND_PRUNE;
+      } else if (strcmp(argv[i], "grid") == 0) {
+        broadphase = SPATIAL_HASH;
+      } else {
+        broadphase = AABB_TREE;
+      }
+    } else if (strcmp(argv[i], "--headless") == 0) {
+      headless = true;
+    } else if (strcmp(argv[i], "--until") == 0 && i + 1 < argc) {
+      until = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--events") == 0 && i + 1 < argc) {
+      max_events = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc) {
+      dump_path = argv[++i];
+    } else if (strcmp(argv[i], "--dump-every") == 0 && i + 1 < argc) {
+      dump_interval = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      threads = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--export-png") == 0 && i + 1 < argc) {
+      export_path = argv[++i];
+      export_format = FrameEncoder::PNG_SEQUENCE;
+    } else if (strcmp(argv[i], "--export-raw") == 0 && i + 1 < argc) {
+      export_path = argv[++i];
+      export_format = FrameEncoder::RAW_VIDEO;
+    } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+      sscanf(argv[++i], "%dx%d", &width, &height);
+    } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+      log_path = argv[++i];
+    } else if (strcmp(argv[i], "--log-quantized") == 0 && i + 1 < argc) {
+      log_path = argv[++i];
+      quantized_log = true;
+    } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+      replay_path = argv[++i];
+    } else if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+      scene_path = argv[++i];
+    } else if (strcmp(argv[i], "--save-scene") == 0 && i + 1 < argc) {
+      save_scene_path = argv[++i];
+    } else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+      checkpoint_path = argv[++i];
+    } else if (strcmp(argv[i], "--checkpoint-every") == 0 && i + 1 < argc) {
+      checkpoint_interval = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--resume") == 0 && i + 1 < argc) {
+      resume_path = argv[++i];
+    } else if (strcmp(argv[i], "--stats") == 0 && i + 1 < argc) {
+      stats_path = argv[++i];
+    } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+      trace_path = argv[++i];
+    } else if (strcmp(argv[i], "--regions") == 0 && i + 1 < argc) {
+      regions = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+      window = atof(argv[++i]);
+    }
+  }
+
+  FILE * dump = NULL;
+  if (dump_path != NULL) {
+    dump = fopen(dump_path, "w");
+    if (dump == NULL) {
+      perror(dump_path);
+      return 1;
+    }
+  }
+
+  // poses straight from a recorded log, nothing is simulated
+  if (replay_path != NULL) {
+    EventLogReader reader;
+    if (!reader.open(replay_path)) {
+      return 1;
+    }
+    Replay replay = Replay(reader);
+    replay.setDump(dump, dump_interval);
+    replay.run(until == FLT_MAX ? reader.endTime() : until);
+    if (dump != NULL) {
+      fclose(dump);
+    }
+    return 0;
+  }
+
+  Scene scene;
+  if (scene_path == NULL) {
+    scene.makeDefault();
+  } else if (!scene.load(scene_path)) {
+    return 1;
+  }
+  // converts a text scene into the quicker binary one
+  if (save_scene_path != NULL) {
+    return scene.saveBinary(save_scene_path) ? 0 : 1;
+  }
+
+  if (stats_path != NULL || trace_path != NULL) {
+#ifndef PROFILE
+    fprintf(stderr, "built without PROFILE, so nothing is measured\n");
+#endif
+    if (trace_path != NULL) {
+      Profiler::shared().startTrace(TRACE_EVENTS);
+    }
+    Profiler::shared().reset();
+    atexit(writeProfile);
+  }
+
+  // a process per slab of the scene, only the poses at the end come back
+  if (regions > 1) {
+    if (until == FLT_MAX) {
+      until = 100.0f;
+    }
+    std::vector<CollisionEvent> events;
+    if (!Region::simulate(scene, regions, broadphase, until, window, events)) {
+      return 1;
+    }
+    if (dump != NULL) {
+      MotionEngine motionengine;
+      std::vector<glm::mat4> poses(events.size());
+      for (int i = 0; i < events.size(); i++) {
+        motionengine.pose(events[i], until, poses[i]);
+      }
+      Headless::writePoses(dump, until, poses);
+      fclose(dump);
+    }
+    return 0;
+  }
+
+  Simulation sim(scene, broadphase);
+  if (threads > 0) {
+    sim.setThreads(threads);
+  }
+  if (resume_path != NULL && !sim.resume(resume_path)) {
+    return 1;
+  }
+  if (log_path != NULL && !sim.setEventLog(log_path, quantized_log)) {
+    return 1;
+  }
+  sim.setCheckpoint(checkpoint_path, checkpoint_interval);
+  if (!headless && export_path == NULL) {
+    sim.run();
+    return 0;
+  }
+
+  if (until == FLT_MAX && max_events == INT_MAX) {
+    // something has to stop it
+    until = 100.0f;
+  }
+  if (export_path != NULL) {
+    return sim.runOffscreen(export_format, export_path, width, height, until) ? 0 : 1;
+  }
+  sim.runHeadless(until, max_events, dump, dump_interval);
+  if (dump != NULL) {
+    fclose(dump);
+  }
 
   return 0;
 }
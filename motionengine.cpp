@@ -2,36 +2,53 @@
 #include <cstdlib>
 #include <cmath>
 #include <iostream>
-#ifdef __APPLE__
-#include <GLUT/glut.h>
-#else
-#include <GL/glut.h>
-#endif
-#include <glm/gtx/transform.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include "collisionevent.h"
+#include "profiler.h"
 
 MotionEngine::MotionEngine() { }
 
 void MotionEngine::pose(CollisionEvent const & event, float time, glm::mat4 & pmat) {
+  PROFILE_SCOPE(PHASE_POSE);
   float dtime = time - event.time();
 
-  glm::mat4 irot = irotate(event.initial_angle(), *(event.initial_axis()));
-  glm::mat4 trot = trotate(dtime, event.angular_velocity(), *(event.axis_of_rotation()));
-  glm::mat4 trans = translate(dtime, *(event.initial_coordinates()), *(event.velocity()));
-
-  pmat = trans * trot * irot;
+  glm::quat rotation;
+  orientation(event, time, rotation);
+  pmat = glm::mat4_cast(rotation);
+  pmat[3] = glm::vec4(*(event.initial_coordinates()) + dtime * *(event.velocity()), 1.0f);
 }
 
-glm::mat4 MotionEngine::irotate(float angle, glm::vec3 const & axis) const {
-  return glm::rotate(angle, axis);
+// Same motion as event, but expressed relative to a later time.
+void MotionEngine::advance(CollisionEvent const & event, float time, CollisionEvent & advanced) {
+  float dtime = time - event.time();
+
+  glm::quat rotation;
+  orientation(event, time, rotation);
+  advanced.setValues(event.object(),
+                     time,
+                     *(event.initial_coordinates()) + dtime * *(event.velocity()),
+                     rotation,
+                     *(event.axis_of_rotation()),
+                     *(event.velocity()),
+                     event.angular_velocity());
 }
 
-glm::mat4 MotionEngine::trotate(float dtime, float angle, glm::vec3 const & axis) const {
-  return glm::rotate(dtime * angle, axis);
+// Spin about axis_of_rotation for dtime on top of the initial orientation.
+// Renormalized so chains of events do not drift away from a rotation.
+void MotionEngine::orientation(CollisionEvent const & event, float time, glm::quat & rotation) const {
+  float dtime = time - event.time();
+  glm::quat spin = glm::angleAxis(dtime * event.angular_velocity(), *(event.axis_of_rotation()));
+  rotation = glm::normalize(spin * *(event.initial_orientation()));
 }
 
-glm::mat4 MotionEngine::translate(float dtime,
-                                         glm::vec3 const & coordinates,
-                                         glm::vec3 const & velocity) const {
-  return glm::translate(coordinates + dtime * velocity);
+// Velocity of the material point of the object that is at point at time.
+void MotionEngine::velocityAt(CollisionEvent const & event,
+                              float time,
+                              glm::vec3 const & point,
+                              glm::vec3 & velocity) const {
+  float dtime = time - event.time();
+  glm::vec3 center = *(event.initial_coordinates()) + dtime * *(event.velocity());
+  glm::vec3 omega = event.angular_velocity() * *(event.axis_of_rotation());
+  velocity = *(event.velocity()) + glm::cross(omega, point - center);
 }
@@ -1,18 +1,19 @@
 #ifndef MOTIONENGINE_H
 #define MOTIONENGINE_H
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include "collisionevent.h"
 
 class MotionEngine {
   public:
     MotionEngine();
     void pose(CollisionEvent const & event, float time, glm::mat4 & pmat);
-
-  private:
-    glm::mat4 irotate(float angle, glm::vec3 const & axis) const;
-    glm::mat4 trotate(float dtime, float angle, glm::vec3 const & axis) const;
-    glm::mat4 translate(float dtime,
-                        glm::vec3 const & coordinates,
-                        glm::vec3 const & velocity) const;
+    void advance(CollisionEvent const & event, float time, CollisionEvent & advanced);
+    void orientation(CollisionEvent const & event, float time, glm::quat & rotation) const;
+    void velocityAt(CollisionEvent const & event,
+                    float time,
+                    glm::vec3 const & point,
+                    glm::vec3 & velocity) const;
 };
 
 #endif
@@ -1,6 +1,7 @@
 #ifndef OBJECT_H
 #define OBJECT_H
 #include <glm/glm.hpp>
+#include "shape.h"
 
 class Object {
   public:
@@ -8,9 +9,11 @@ class Object {
     virtual const glm::highp_uvec3 * tris() const = 0;
     virtual int numverts() const = 0;
     virtual int numtris() const = 0;
-    virtual int mass() const = 0;
+    virtual float mass() const = 0;
     virtual float inertia(glm::vec3 const & axis) const = 0;
+    virtual void inertiaTensor(glm::mat3 & tensor) const = 0;
     virtual void normalToEdge(glm::vec3 const & point, glm::vec3 & normal) const = 0;
+    virtual Shape const * shape() const = 0;
 };
 
 #endif
@@ -0,0 +1,149 @@
+#define GL_GLEXT_PROTOTYPES
+#include "offscreen.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#ifndef __APPLE__
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+#endif
+#include <glm/glm.hpp>
+#include "dummyengine.h"
+#include "frameencoder.h"
+#include "object.h"
+#include "scenerenderer.h"
+
+using namespace std;
+
+Offscreen::Offscreen() { }
+
+Offscreen::Offscreen(DummyEngine & dummyengine, vector<Object*> const & objects) {
+  dummyengine_ = &dummyengine;
+  objects_ = &objects;
+}
+
+#ifdef __APPLE__
+
+bool Offscreen::run(FrameEncoder::Format format,
+                    char const * path,
+                    int width,
+                    int height,
+                    float step,
+                    float until) {
+  fprintf(stderr, "offscreen rendering needs EGL\n");
+  return false;
+}
+
+#else
+
+// Prefers Mesa's surfaceless platform, which needs neither X nor a GPU.
+static EGLDisplay openDisplay() {
+  char const * extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+  if (extensions != NULL && strstr(extensions, "EGL_MESA_platform_surfaceless") != NULL) {
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+      (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay != NULL) {
+      EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+      if (display != EGL_NO_DISPLAY && eglInitialize(display, NULL, NULL)) {
+        return display;
+      }
+    }
+  }
+
+  EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  if (display != EGL_NO_DISPLAY && eglInitialize(display, NULL, NULL)) {
+    return display;
+  }
+  return EGL_NO_DISPLAY;
+}
+
+bool Offscreen::run(FrameEncoder::Format format,
+                    char const * path,
+                    int width,
+                    int height,
+                    float step,
+                    float until) {
+  EGLDisplay display = openDisplay();
+  if (display == EGL_NO_DISPLAY || !eglBindAPI(EGL_OPENGL_API)) {
+    fprintf(stderr, "no EGL display with desktop OpenGL\n");
+    return false;
+  }
+
+  EGLint config_attributes[] = {
+    EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_RED_SIZE, 8,
+    EGL_GREEN_SIZE, 8,
+    EGL_BLUE_SIZE, 8,
+    EGL_ALPHA_SIZE, 8,
+    EGL_DEPTH_SIZE, 24,
+    EGL_NONE
+  };
+  EGLConfig config;
+  EGLint num_configs = 0;
+  eglChooseConfig(display, config_attributes, &config, 1, &num_configs);
+  if (num_configs == 0) {
+    fprintf(stderr, "no EGL config for an RGBA pbuffer with depth\n");
+    eglTerminate(display);
+    return false;
+  }
+
+  EGLint surface_attributes[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+  EGLSurface surface = eglCreatePbufferSurface(display, config, surface_attributes);
+  // the scene is drawn with fixed function matrices
+  EGLint context_attributes[] = {
+    EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+    EGL_NONE
+  };
+  EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attributes);
+  if (surface == EGL_NO_SURFACE || context == EGL_NO_CONTEXT ||
+      !eglMakeCurrent(display, surface, surface, context)) {
+    fprintf(stderr, "could not make an EGL pbuffer context current\n");
+    eglTerminate(display);
+    return false;
+  }
+
+  FrameEncoder encoder;
+  bool ok = encoder.open(format, path, width, height);
+  if (ok) {
+    SceneRenderer scene;
+    scene.init(*objects_);
+    scene.reshape(width, height);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    float first = dummyengine_->time();  // after 0 when resumed from a checkpoint
+    for (int k = 0; ; k++) {
+      float time = min(first + k * step, until);
+      dummyengine_->getPoses(time, poses_);
+      scene.draw(poses_);
+      // only waits when the encoder has fallen behind by every buffer
+      glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, encoder.buffer());
+      encoder.submit();
+      if (time >= until) {
+        break;
+      }
+    }
+    double rendered = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    ok = encoder.close();
+    double written = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("%d frames of %dx%d up to time %g, rendered in %.3f s, written in %.3f s (%.1f frames/s)\n",
+           encoder.frames(), width, height, until, rendered, written,
+           written > 0.0 ? encoder.frames() / written : 0.0);
+    if (!ok) {
+      fprintf(stderr, "some frames could not be written to %s\n", path);
+    }
+  }
+
+  eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+  eglDestroyContext(display, context);
+  eglDestroySurface(display, surface);
+  eglTerminate(display);
+  return ok;
+}
+
+#endif
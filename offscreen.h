@@ -0,0 +1,34 @@
+#ifndef OFFSCREEN_H
+#define OFFSCREEN_H
+#include <vector>
+#include <glm/glm.hpp>
+#include "dummyengine.h"
+#include "frameencoder.h"
+#include "object.h"
+#include "scenerenderer.h"
+
+// Renders what the viewer would show into an EGL pbuffer, one frame per
+// fixed step of simulated time, and hands the frames to a FrameEncoder.
+// Works without a display, e.g. on llvmpipe.
+class Offscreen {
+  public:
+    Offscreen();
+    Offscreen(DummyEngine & dummyengine, std::vector<Object*> const & objects);
+
+    // Renders from 0 to until, the last frame at exactly until, then
+    // prints how fast it went. Returns false if there was no context or a
+    // frame could not be written.
+    bool run(FrameEncoder::Format format,
+             char const * path,
+             int width,
+             int height,
+             float step,
+             float until);
+
+  private:
+    DummyEngine * dummyengine_;
+    std::vector<Object*> const * objects_;
+    std::vector<glm::mat4> poses_;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#include "pool.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#define POOL_SLAB 65536  // bytes
+#define POOL_ALIGNMENT 16
+
+using namespace std;
+
+Pool::Pool() {
+  block_size_ = 0;
+  blocks_per_slab_ = 0;
+  free_ = NULL;
+}
+
+Pool::Pool(size_t block_size) {
+  block_size = max(block_size, sizeof(void *));
+  block_size_ = (block_size + POOL_ALIGNMENT - 1) / POOL_ALIGNMENT * POOL_ALIGNMENT;
+  blocks_per_slab_ = max((size_t)1, POOL_SLAB / block_size_);
+  free_ = NULL;
+}
+
+void * Pool::allocate() {
+  if (free_ == NULL) {
+    grow();
+  }
+  void * block = free_;
+  free_ = *(void **)block;
+  return block;
+}
+
+void Pool::release(void * block) {
+  *(void **)block = free_;
+  free_ = block;
+}
+
+size_t Pool::blockSize() const {
+  return block_size_;
+}
+
+void Pool::grow() {
+  slabs_.push_back(unique_ptr<char[]>(new char[blocks_per_slab_ * block_size_]));
+  char * slab = slabs_.back().get();
+  for (int i = blocks_per_slab_ - 1; i >= 0; i--) {
+    release(slab + i * block_size_);
+  }
+}
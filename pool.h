@@ -0,0 +1,74 @@
+#ifndef POOL_H
+#define POOL_H
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Blocks of one size, carved out of slabs of many at a time. Released
+// blocks go on a free list for the next allocation, and the slabs only go
+// back to the heap with the pool, so something that keeps releasing as
+// much as it allocates stops touching the heap.
+class Pool {
+  public:
+    Pool();
+    Pool(size_t block_size);
+
+    void * allocate();
+    void release(void * block);
+    size_t blockSize() const;
+
+  private:
+    void grow();
+
+    size_t block_size_;
+    int blocks_per_slab_;
+    std::vector<std::unique_ptr<char[]> > slabs_;
+    void * free_;  // each free block starts with a pointer to the next
+};
+
+// For node based containers. Single nodes that fit come from the pool,
+// anything else, like the buckets of a hash map, from the heap.
+template <typename T>
+class PoolAllocator {
+  public:
+    typedef T value_type;
+
+    PoolAllocator(Pool * pool) : pool_(pool) { }
+    template <typename U>
+    PoolAllocator(PoolAllocator<U> const & other) : pool_(other.pool()) { }
+
+    T * allocate(size_t n) {
+      if (n == 1 && sizeof(T) <= pool_->blockSize()) {
+        return static_cast<T *>(pool_->allocate());
+      }
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T * p, size_t n) {
+      if (n == 1 && sizeof(T) <= pool_->blockSize()) {
+        pool_->release(p);
+      } else {
+        ::operator delete(p);
+      }
+    }
+
+    Pool * pool() const {
+      return pool_;
+    }
+
+  private:
+    Pool * pool_;
+};
+
+template <typename T, typename U>
+bool operator==(PoolAllocator<T> const & a, PoolAllocator<U> const & b) {
+  return a.pool() == b.pool();
+}
+
+template <typename T, typename U>
+bool operator!=(PoolAllocator<T> const & a, PoolAllocator<U> const & b) {
+  return a.pool() != b.pool();
+}
+
+#endif
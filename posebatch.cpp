@@ -0,0 +1,244 @@
+#include "posebatch.h"
+#include <cmath>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "collisionevent.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86 1
+#endif
+
+// The kernel has to be inlined into evaluateAvx2 to be compiled for AVX2.
+#if defined(__GNUC__)
+#define INLINE __attribute__((always_inline))
+#else
+#define INLINE
+#endif
+
+#define MAX_WIDTH 8  // widest lanes, arrays are padded to a multiple of it
+
+// pi / 2 split in three so the range reduction stays exact
+#define PIO2_1 1.5703125f
+#define PIO2_2 4.837512969970703125e-4f
+#define PIO2_3 7.54978995489188216e-8f
+
+// Each set of lanes provides the handful of operations the kernel needs,
+// so the kernel itself is written once.
+struct ScalarLanes {
+  typedef float V;
+  static const int WIDTH = 1;
+  static V set1(float a) { return a; }
+  static V load(float const * p) { return *p; }
+  static void store(float * p, V a) { *p = a; }
+  static V add(V a, V b) { return a + b; }
+  static V sub(V a, V b) { return a - b; }
+  static V mul(V a, V b) { return a * b; }
+  static V floor(V a) { return std::floor(a); }
+};
+
+#ifdef HAVE_X86
+struct SseLanes {
+  typedef __m128 V;
+  static const int WIDTH = 4;
+  static V set1(float a) { return _mm_set1_ps(a); }
+  static V load(float const * p) { return _mm_loadu_ps(p); }
+  static void store(float * p, V a) { _mm_storeu_ps(p, a); }
+  static V add(V a, V b) { return _mm_add_ps(a, b); }
+  static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+  static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+  static V floor(V a) {
+    // SSE2 only truncates, so step down where that rounded up
+    V truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+    return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, a), _mm_set1_ps(1.0f)));
+  }
+};
+
+// everything taking or returning __m256 is inlined, so the ABI note does
+// not apply
+#pragma GCC diagnostic ignored "-Wpsabi"
+#define AVX2 __attribute__((target("avx2")))
+struct Avx2Lanes {
+  typedef __m256 V;
+  static const int WIDTH = 8;
+  AVX2 static V set1(float a) { return _mm256_set1_ps(a); }
+  AVX2 static V load(float const * p) { return _mm256_loadu_ps(p); }
+  AVX2 static void store(float * p, V a) { _mm256_storeu_ps(p, a); }
+  AVX2 static V add(V a, V b) { return _mm256_add_ps(a, b); }
+  AVX2 static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+  AVX2 static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+  AVX2 static V floor(V a) { return _mm256_floor_ps(a); }
+};
+#endif
+
+// sin and cos of angle: reduce to r in [-pi/4, pi/4] and the quadrant k,
+// then swap and negate the two polynomials by quadrant. Blending with 0 or 1
+// instead of masks keeps it to plain arithmetic.
+template <typename Lanes>
+static inline INLINE void sincos(typename Lanes::V const & angle, typename Lanes::V & s, typename Lanes::V & c) {
+  typedef typename Lanes::V V;
+  V one = Lanes::set1(1.0f);
+  V half = Lanes::set1(0.5f);
+  V quarter = Lanes::set1(0.25f);
+
+  V k = Lanes::floor(Lanes::add(Lanes::mul(angle, Lanes::set1(0.63661977236f)), half));
+  V r = Lanes::sub(angle, Lanes::mul(k, Lanes::set1(PIO2_1)));
+  r = Lanes::sub(r, Lanes::mul(k, Lanes::set1(PIO2_2)));
+  r = Lanes::sub(r, Lanes::mul(k, Lanes::set1(PIO2_3)));
+  V r2 = Lanes::mul(r, r);
+
+  V sr = Lanes::add(Lanes::mul(r2, Lanes::set1(-1.9515295891e-4f)), Lanes::set1(8.3321608736e-3f));
+  sr = Lanes::add(Lanes::mul(sr, r2), Lanes::set1(-1.6666654611e-1f));
+  sr = Lanes::add(Lanes::mul(Lanes::mul(sr, r2), r), r);
+
+  V cr = Lanes::add(Lanes::mul(r2, Lanes::set1(2.443315711809948e-5f)), Lanes::set1(-1.388731625493765e-3f));
+  cr = Lanes::add(Lanes::mul(cr, r2), Lanes::set1(4.166664568298827e-2f));
+  cr = Lanes::add(Lanes::mul(Lanes::mul(cr, r2), r2), Lanes::sub(one, Lanes::mul(half, r2)));
+
+  // odd quadrants swap sin and cos
+  V odd = Lanes::sub(k, Lanes::mul(Lanes::set1(2.0f), Lanes::floor(Lanes::mul(k, half))));
+  V swapped_s = Lanes::add(sr, Lanes::mul(odd, Lanes::sub(cr, sr)));
+  V swapped_c = Lanes::add(cr, Lanes::mul(odd, Lanes::sub(sr, cr)));
+
+  // sin is negative in quadrants 2 and 3, cos in quadrants 1 and 2
+  V quadrant_s = Lanes::sub(k, Lanes::mul(Lanes::set1(4.0f), Lanes::floor(Lanes::mul(k, quarter))));
+  V kc = Lanes::add(k, one);
+  V quadrant_c = Lanes::sub(kc, Lanes::mul(Lanes::set1(4.0f), Lanes::floor(Lanes::mul(kc, quarter))));
+  V sign_s = Lanes::sub(one, Lanes::mul(Lanes::set1(2.0f), Lanes::floor(Lanes::mul(quadrant_s, half))));
+  V sign_c = Lanes::sub(one, Lanes::mul(Lanes::set1(2.0f), Lanes::floor(Lanes::mul(quadrant_c, half))));
+
+  s = Lanes::mul(swapped_s, sign_s);
+  c = Lanes::mul(swapped_c, sign_c);
+}
+
+PoseBatch::PoseBatch() {
+  size_ = 0;
+}
+
+void PoseBatch::resize(int num_objects) {
+  size_ = num_objects;
+  int padded = ((num_objects + MAX_WIDTH - 1) / MAX_WIDTH) * MAX_WIDTH;
+
+  // padding lanes stand still, which keeps them finite
+  time_.resize(padded, 0.0f);
+  angular_velocity_.resize(padded, 0.0f);
+  for (int i = 0; i < 3; i++) {
+    coordinates_[i].resize(padded, 0.0f);
+    velocity_[i].resize(padded, 0.0f);
+    axis_[i].resize(padded, (i == 0) ? 1.0f : 0.0f);
+  }
+  for (int i = 0; i < 9; i++) {
+    initial_rotation_[i].resize(padded, (i % 4 == 0) ? 1.0f : 0.0f);
+  }
+}
+
+void PoseBatch::set(CollisionEvent const & event) {
+  int id = event.object();
+  time_[id] = event.time();
+  angular_velocity_[id] = event.angular_velocity();
+
+  glm::vec3 axis = *event.axis_of_rotation();
+  float length = glm::length(axis);
+  axis = (length > 0.0f) ? axis / length : glm::vec3(1.0f, 0.0f, 0.0f);
+
+  glm::mat3 initial = glm::mat3_cast(*event.initial_orientation());
+  for (int i = 0; i < 3; i++) {
+    coordinates_[i][id] = (*event.initial_coordinates())[i];
+    velocity_[i][id] = (*event.velocity())[i];
+    axis_[i][id] = axis[i];
+    for (int j = 0; j < 3; j++) {
+      initial_rotation_[3 * i + j][id] = initial[j][i];
+    }
+  }
+}
+
+int PoseBatch::size() const {
+  return size_;
+}
+
+void PoseBatch::evaluate(float time, glm::mat4 * poses) const {
+#ifdef HAVE_X86
+  if (__builtin_cpu_supports("avx2")) {
+    evaluateAvx2(time, poses);
+  } else {
+    evaluateLanes<SseLanes>(time, poses);
+  }
+#else
+  evaluateLanes<ScalarLanes>(time, poses);
+#endif
+}
+
+// pose = translate(coordinates + dtime * velocity)
+//        * rotate(dtime * angular_velocity, axis) * initial_rotation
+template <typename Lanes>
+inline INLINE void PoseBatch::evaluateLanes(float time, glm::mat4 * poses) const {
+  typedef typename Lanes::V V;
+  V now = Lanes::set1(time);
+  V one = Lanes::set1(1.0f);
+
+  for (int begin = 0; begin < size_; begin += Lanes::WIDTH) {
+    V dtime = Lanes::sub(now, Lanes::load(&time_[begin]));
+
+    V s, c;
+    sincos<Lanes>(Lanes::mul(dtime, Lanes::load(&angular_velocity_[begin])), s, c);
+    V t = Lanes::sub(one, c);
+
+    // Rodrigues' rotation about the normalized axis
+    V x = Lanes::load(&axis_[0][begin]);
+    V y = Lanes::load(&axis_[1][begin]);
+    V z = Lanes::load(&axis_[2][begin]);
+    V tx = Lanes::mul(t, x);
+    V ty = Lanes::mul(t, y);
+    V tz = Lanes::mul(t, z);
+    V rotation[9] = {
+      Lanes::add(Lanes::mul(tx, x), c),
+      Lanes::sub(Lanes::mul(tx, y), Lanes::mul(s, z)),
+      Lanes::add(Lanes::mul(tx, z), Lanes::mul(s, y)),
+      Lanes::add(Lanes::mul(tx, y), Lanes::mul(s, z)),
+      Lanes::add(Lanes::mul(ty, y), c),
+      Lanes::sub(Lanes::mul(ty, z), Lanes::mul(s, x)),
+      Lanes::sub(Lanes::mul(tx, z), Lanes::mul(s, y)),
+      Lanes::add(Lanes::mul(ty, z), Lanes::mul(s, x)),
+      Lanes::add(Lanes::mul(tz, z), c)
+    };
+
+    V initial[9];
+    for (int i = 0; i < 9; i++) {
+      initial[i] = Lanes::load(&initial_rotation_[i][begin]);
+    }
+
+    // rows of the combined rotation, then the translation column
+    float out[12][MAX_WIDTH];
+    for (int row = 0; row < 3; row++) {
+      for (int column = 0; column < 3; column++) {
+        V sum = Lanes::mul(rotation[3 * row], initial[column]);
+        sum = Lanes::add(sum, Lanes::mul(rotation[3 * row + 1], initial[3 + column]));
+        sum = Lanes::add(sum, Lanes::mul(rotation[3 * row + 2], initial[6 + column]));
+        Lanes::store(out[3 * row + column], sum);
+      }
+      V position = Lanes::add(Lanes::load(&coordinates_[row][begin]),
+                              Lanes::mul(dtime, Lanes::load(&velocity_[row][begin])));
+      Lanes::store(out[9 + row], position);
+    }
+
+    int end = (begin + Lanes::WIDTH < size_) ? begin + Lanes::WIDTH : size_;
+    for (int i = begin; i < end; i++) {
+      int lane = i - begin;
+      glm::mat4 & pose = poses[i];
+      for (int column = 0; column < 3; column++) {
+        pose[column] = glm::vec4(out[column][lane], out[3 + column][lane], out[6 + column][lane], 0.0f);
+      }
+      pose[3] = glm::vec4(out[9][lane], out[10][lane], out[11][lane], 1.0f);
+    }
+  }
+}
+
+#ifdef HAVE_X86
+AVX2 void PoseBatch::evaluateAvx2(float time, glm::mat4 * poses) const {
+  evaluateLanes<Avx2Lanes>(time, poses);
+}
+#else
+void PoseBatch::evaluateAvx2(float time, glm::mat4 * poses) const {
+  evaluateLanes<ScalarLanes>(time, poses);
+}
+#endif
@@ -0,0 +1,36 @@
+#ifndef POSEBATCH_H
+#define POSEBATCH_H
+#include <vector>
+#include <glm/glm.hpp>
+#include "collisionevent.h"
+
+// Structure of arrays copy of the current motion of every object, so the
+// poses of all of them at one time can be evaluated in a single pass with
+// SSE or AVX2 instead of one MotionEngine::pose call per object. Gives the
+// same poses as MotionEngine::pose.
+class PoseBatch {
+  public:
+    PoseBatch();
+
+    void resize(int num_objects);
+    void set(CollisionEvent const & event);
+    int size() const;
+
+    // poses needs room for size() matrices
+    void evaluate(float time, glm::mat4 * poses) const;
+
+  private:
+    template <typename Lanes>
+    void evaluateLanes(float time, glm::mat4 * poses) const;
+    void evaluateAvx2(float time, glm::mat4 * poses) const;
+
+    int size_;
+    std::vector<float> time_;
+    std::vector<float> coordinates_[3];
+    std::vector<float> velocity_[3];
+    std::vector<float> axis_[3];  // normalized axis_of_rotation
+    std::vector<float> angular_velocity_;
+    std::vector<float> initial_rotation_[9];  // row major, applied first
+};
+
+#endif
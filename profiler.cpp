@@ -0,0 +1,187 @@
+#include "profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#define TRACE_RESERVE 4096  // events per thread before the first reallocation
+
+using namespace std;
+
+static const char * PHASE_NAMES[NUM_PHASES] = {
+  "event_pop", "broad_phase", "narrow_phase", "collision_response", "pose", "render"
+};
+
+static const char * COUNTER_NAMES[NUM_COUNTERS] = {
+  "events", "pairs_tested", "pairs_colliding", "allocations"
+};
+
+#ifdef PROFILE
+// Counts every heap allocation, so that a run can tell whether the engine
+// still allocates once it is going. Arrays and nothrow allocations end up
+// in here as well.
+void * operator new(size_t size) {
+  Profiler::shared().count(COUNTER_ALLOCATIONS, 1);
+  void * p = malloc((size > 0) ? size : 1);
+  if (p == NULL) {
+    throw bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void * p) noexcept {
+  free(p);
+}
+
+void operator delete(void * p, size_t) noexcept {
+  free(p);
+}
+#endif
+
+Profiler::Profiler() {
+  epoch_ = chrono::steady_clock::now();
+  tracing_.store(false);
+  trace_budget_.store(0);
+  trace_dropped_.store(0);
+  reset();
+}
+
+Profiler & Profiler::shared() {
+  static Profiler profiler;
+  return profiler;
+}
+
+char const * Profiler::phaseName(int phase) {
+  return PHASE_NAMES[phase];
+}
+
+char const * Profiler::counterName(int counter) {
+  return COUNTER_NAMES[counter];
+}
+
+void Profiler::record(Phase phase, long long start, long long end) {
+  calls_[phase].fetch_add(1, memory_order_relaxed);
+  nanoseconds_[phase].fetch_add(end - start, memory_order_relaxed);
+  if (tracing_.load(memory_order_relaxed)) {
+    trace(phase, start, end - start);
+  }
+}
+
+void Profiler::count(Counter counter, long long n) {
+  counters_[counter].fetch_add(n, memory_order_relaxed);
+}
+
+void Profiler::queueDepth(int depth) {
+  queue_depth_.store(depth, memory_order_relaxed);
+  int highest = max_queue_depth_.load(memory_order_relaxed);
+  while (depth > highest && !max_queue_depth_.compare_exchange_weak(highest, depth)) { }
+  if (tracing_.load(memory_order_relaxed)) {
+    trace(-1, now(), depth);
+  }
+}
+
+void Profiler::stats(Stats & stats) const {
+  stats.seconds = (now() - start_.load()) * 1e-9;
+  for (int i = 0; i < NUM_PHASES; i++) {
+    stats.phases[i].calls = calls_[i].load();
+    stats.phases[i].seconds = nanoseconds_[i].load() * 1e-9;
+  }
+  for (int i = 0; i < NUM_COUNTERS; i++) {
+    stats.counters[i] = counters_[i].load();
+  }
+  stats.queue_depth = queue_depth_.load();
+  stats.max_queue_depth = max_queue_depth_.load();
+}
+
+void Profiler::reset() {
+  start_.store(now());
+  for (int i = 0; i < NUM_PHASES; i++) {
+    calls_[i].store(0);
+    nanoseconds_[i].store(0);
+  }
+  for (int i = 0; i < NUM_COUNTERS; i++) {
+    counters_[i].store(0);
+  }
+  queue_depth_.store(0);
+  max_queue_depth_.store(0);
+}
+
+void Profiler::startTrace(long long max_events) {
+  trace_budget_.store(max_events);
+  trace_dropped_.store(0);
+  tracing_.store(true);
+}
+
+// Every thread appends to a buffer of its own, found through a thread
+// local, so recording takes no lock once a thread has its buffer.
+void Profiler::trace(int phase, long long start, long long value) {
+  if (trace_budget_.fetch_sub(1, memory_order_relaxed) <= 0) {
+    trace_dropped_.fetch_add(1, memory_order_relaxed);
+    return;
+  }
+
+  static thread_local ThreadTrace * thread_trace = NULL;
+  if (thread_trace == NULL) {
+    lock_guard<mutex> lock(traces_mutex_);
+    traces_.push_back(unique_ptr<ThreadTrace>(new ThreadTrace()));
+    thread_trace = traces_.back().get();
+    thread_trace->thread = traces_.size();
+    thread_trace->events.reserve(TRACE_RESERVE);
+  }
+  TraceEvent event = { phase, start, value };
+  thread_trace->events.push_back(event);
+}
+
+bool Profiler::writeStats(FILE * file) const {
+  Stats s;
+  stats(s);
+  fprintf(file, "{\n  \"seconds\": %.6f,\n", s.seconds);
+  for (int i = 0; i < NUM_COUNTERS; i++) {
+    fprintf(file, "  \"%s\": %lld,\n", COUNTER_NAMES[i], s.counters[i]);
+  }
+  fprintf(file, "  \"events_per_second\": %.1f,\n",
+          (s.seconds > 0.0) ? s.counters[COUNTER_EVENTS] / s.seconds : 0.0);
+  fprintf(file, "  \"queue_depth\": %d,\n  \"max_queue_depth\": %d,\n",
+          s.queue_depth, s.max_queue_depth);
+  fprintf(file, "  \"phases\": {\n");
+  for (int i = 0; i < NUM_PHASES; i++) {
+    fprintf(file, "    \"%s\": { \"calls\": %lld, \"seconds\": %.6f }%s\n",
+            PHASE_NAMES[i], s.phases[i].calls, s.phases[i].seconds,
+            (i + 1 < NUM_PHASES) ? "," : "");
+  }
+  fprintf(file, "  }\n}\n");
+  return !ferror(file);
+}
+
+// Timed scopes become complete ("X") events and the queue depth a counter
+// ("C") track, with times in microseconds as the format wants.
+bool Profiler::writeTrace(FILE * file) const {
+  lock_guard<mutex> lock(traces_mutex_);
+  fprintf(file, "{\"traceEvents\":[\n");
+  bool first = true;
+  for (int t = 0; t < traces_.size(); t++) {
+    ThreadTrace const & thread_trace = *traces_[t];
+    for (int k = 0; k < thread_trace.events.size(); k++) {
+      TraceEvent const & event = thread_trace.events[k];
+      if (event.phase < 0) {
+        fprintf(file, "%s{\"name\":\"queue_depth\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,"
+                      "\"tid\":%d,\"args\":{\"events\":%lld}}",
+                first ? "" : ",\n", event.start * 1e-3, thread_trace.thread, event.value);
+      } else {
+        fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"engine\",\"ph\":\"X\",\"ts\":%.3f,"
+                      "\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                first ? "" : ",\n", PHASE_NAMES[event.phase], event.start * 1e-3,
+                event.value * 1e-3, thread_trace.thread);
+      }
+      first = false;
+    }
+  }
+  fprintf(file, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":%lld}}\n",
+          trace_dropped_.load());
+  return !ferror(file);
+}
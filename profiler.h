@@ -0,0 +1,132 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Stages of the engine that get timed. Phases nest, so the time of one
+// includes that of any phase timed inside it, like the poses evaluated
+// during the narrow phase.
+enum Phase {
+  PHASE_EVENT_POP,
+  PHASE_BROAD_PHASE,
+  PHASE_NARROW_PHASE,
+  PHASE_COLLISION_RESPONSE,  // Collision::generateCollisionEvents
+  PHASE_POSE,                // MotionEngine::pose
+  PHASE_RENDER,
+  NUM_PHASES
+};
+
+enum Counter {
+  COUNTER_EVENTS,  // applied
+  COUNTER_PAIRS_TESTED,
+  COUNTER_PAIRS_COLLIDING,
+  COUNTER_ALLOCATIONS,  // operator new, anywhere in the process
+  NUM_COUNTERS
+};
+
+struct PhaseStats {
+  long long calls;
+  double seconds;
+};
+
+struct Stats {
+  double seconds;  // since the counts were started
+  PhaseStats phases[NUM_PHASES];
+  long long counters[NUM_COUNTERS];
+  int queue_depth;  // after the latest batch of events
+  int max_queue_depth;
+};
+
+// Counts and times for the whole process, from any thread. The engine only
+// reports to it in builds with PROFILE defined, otherwise the PROFILE_
+// macros below are empty and everything stays at 0.
+class Profiler {
+  public:
+    static Profiler & shared();
+    static char const * phaseName(int phase);
+    static char const * counterName(int counter);
+
+    // nanoseconds since the profiler was made
+    long long now() const {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - epoch_).count();
+    }
+
+    void record(Phase phase, long long start, long long end);
+    void count(Counter counter, long long n);
+    void queueDepth(int depth);
+
+    void stats(Stats & stats) const;
+    void reset();
+    // Keeps every timed scope and queue depth from now on for writeTrace,
+    // at most max_events of them.
+    void startTrace(long long max_events);
+
+    bool writeStats(FILE * file) const;  // JSON
+    // Chrome trace_event JSON, for chrome://tracing or Perfetto
+    bool writeTrace(FILE * file) const;
+
+  private:
+    struct TraceEvent {
+      int phase;  // -1 for the queue depth
+      long long start;
+      long long value;  // duration, or the queue depth
+    };
+    // only ever written by its own thread
+    struct ThreadTrace {
+      int thread;
+      std::vector<TraceEvent> events;
+    };
+
+    Profiler();
+    void trace(int phase, long long start, long long value);
+
+    std::chrono::steady_clock::time_point epoch_;
+    std::atomic<long long> start_;
+    std::atomic<long long> calls_[NUM_PHASES];
+    std::atomic<long long> nanoseconds_[NUM_PHASES];
+    std::atomic<long long> counters_[NUM_COUNTERS];
+    std::atomic<int> queue_depth_;
+    std::atomic<int> max_queue_depth_;
+
+    std::atomic<bool> tracing_;
+    std::atomic<long long> trace_budget_;
+    std::atomic<long long> trace_dropped_;
+    mutable std::mutex traces_mutex_;
+    std::vector<std::unique_ptr<ThreadTrace> > traces_;
+};
+
+// Adds the time until it goes out of scope to a phase.
+class ScopedTimer {
+  public:
+    ScopedTimer(Phase phase) {
+      phase_ = phase;
+      start_ = Profiler::shared().now();
+    }
+    ~ScopedTimer() {
+      Profiler & profiler = Profiler::shared();
+      profiler.record(phase_, start_, profiler.now());
+    }
+
+  private:
+    Phase phase_;
+    long long start_;
+};
+
+#ifdef PROFILE
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(phase) ScopedTimer PROFILE_CONCAT(profile_scope_, __LINE__)(phase)
+#define PROFILE_COUNT(counter, n) Profiler::shared().count(counter, n)
+#define PROFILE_QUEUE_DEPTH(depth) Profiler::shared().queueDepth(depth)
+#else
+#define PROFILE_SCOPE(phase) ((void)0)
+#define PROFILE_COUNT(counter, n) ((void)0)
+#define PROFILE_QUEUE_DEPTH(depth) ((void)0)
+#endif
+
+#endif
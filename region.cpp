@@ -0,0 +1,485 @@
+#include "region.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <glm/glm.hpp>
+#include "broadphase.h"
+#include "collisionevent.h"
+#include "dummyengine.h"
+#include "eventlog.h"
+#include "motionengine.h"
+#include "object.h"
+#include "scene.h"
+
+#define GHOST_SLACK 1.5f  // collisions can speed objects up within a window
+
+using namespace std;
+
+static_assert(sizeof(RegionMessage) == 16, "region message layout");
+static_assert(sizeof(RegionReport) == 32, "region report layout");
+
+static bool writeAll(int fd, void const * data, size_t size) {
+  char const * bytes = (char const *)data;
+  while (size > 0) {
+    ssize_t n = send(fd, bytes, size, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    bytes += n;
+    size -= n;
+  }
+  return true;
+}
+
+static bool readAll(int fd, void * data, size_t size) {
+  char * bytes = (char *)data;
+  while (size > 0) {
+    ssize_t n = recv(fd, bytes, size, 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    bytes += n;
+    size -= n;
+  }
+  return true;
+}
+
+Region::Region(Scene const & scene, int index, float low, float high, BroadPhaseType broadphase) {
+  scene_ = &scene;
+  objects_ = scene.objects();
+  index_ = index;
+  low_ = low;
+  high_ = high;
+  links_[0] = -1;
+  links_[1] = -1;
+  neighbour_speed_ = 0.0f;
+  window_ = 0;
+  events_ = 0;
+  handoffs_ = 0;
+  ghosts_ = 0;
+
+  int n = objects_.size();
+  roles_.assign(n, ABSENT);
+  ghost_windows_.assign(n, -1);
+
+  max_radius_ = 0.0f;
+  vector<CollisionEvent> initial_events;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < objects_[i]->numverts(); j++) {
+      max_radius_ = max(max_radius_, glm::length(glm::vec3(objects_[i]->verts()[j])));
+    }
+    CollisionEvent const & event = scene.events()[i];
+    float x = (*event.initial_coordinates()).x;
+    if (x >= low_ && x < high_) {
+      roles_[i] = OWNED;
+      owned_.push_back(i);
+      initial_events.push_back(event);
+    }
+  }
+
+  dummyengine_ = DummyEngine(motionengine_, objects_, initial_events);
+  dummyengine_.setBroadPhase(broadphase);
+  // the processes are what runs in parallel
+  dummyengine_.setThreads(1);
+}
+
+void Region::setLinks(int left, int right) {
+  links_[0] = left;
+  links_[1] = right;
+  for (int side = 0; side < 2; side++) {
+    if (links_[side] != -1) {
+      fcntl(links_[side], F_SETFL, fcntl(links_[side], F_GETFL) | O_NONBLOCK);
+    }
+  }
+}
+
+bool Region::run(float until, float window) {
+  float time = 0.0f;
+  while (true) {
+    if (!exchange(time, window)) {
+      fprintf(stderr, "region %d: lost a neighbour at time %g\n", index_, time);
+      return false;
+    }
+    if (time >= until) {
+      return true;
+    }
+    float next = min(time + window, until);
+    events_ += dummyengine_.processEvents(next, INT_MAX);
+    time = next;
+  }
+}
+
+bool Region::report(int fd) const {
+  RegionReport report;
+  memset(&report, 0, sizeof(report));
+  report.owned = owned_.size();
+  report.events = events_;
+  report.handoffs = handoffs_;
+  report.ghosts = ghosts_;
+  if (!writeAll(fd, &report, sizeof(report))) {
+    return false;
+  }
+
+  vector<EventRecord> records(owned_.size());
+  for (int k = 0; k < owned_.size(); k++) {
+    packEvent(dummyengine_.latestEvent(owned_[k]), records[k]);
+  }
+  return writeAll(fd, records.data(), records.size() * sizeof(EventRecord));
+}
+
+// Sends each neighbour what it needs from this region for the window
+// starting at time, and takes in what they send back.
+bool Region::exchange(float time, float window) {
+  float speed = maxSpeed();
+  float band = GHOST_SLACK * (speed + neighbour_speed_) * window + 2.0f * max_radius_;
+
+  vector<EventRecord> handoffs[2];
+  vector<EventRecord> ghosts[2];
+  int kept = 0;
+  for (int k = 0; k < owned_.size(); k++) {
+    int id = owned_[k];
+    // the initial events are still in the queue before the first window
+    CollisionEvent const & motion = (window_ == 0) ? scene_->events()[id]
+                                                   : dummyengine_.latestEvent(id);
+    float x = (*motion.initial_coordinates()).x + (time - motion.time()) * (*motion.velocity()).x;
+    EventRecord record;
+    packEvent(motion, record);
+
+    int side = -1;
+    if (x < low_ && links_[0] != -1) {
+      side = 0;
+    } else if (x >= high_ && links_[1] != -1) {
+      side = 1;
+    }
+    if (side != -1) {
+      // stays as a ghost for this window, the new owner sends it from then on
+      handoffs[side].push_back(record);
+      roles_[id] = GHOST;
+      ghost_windows_[id] = window_;
+      ghost_ids_.push_back(id);
+      handoffs_++;
+      continue;
+    }
+
+    owned_[kept++] = id;
+    if (links_[0] != -1 && x - low_ < band) {
+      ghosts[0].push_back(record);
+    }
+    if (links_[1] != -1 && high_ - x < band) {
+      ghosts[1].push_back(record);
+    }
+  }
+  owned_.resize(kept);
+
+  for (int side = 0; side < 2; side++) {
+    if (links_[side] == -1) {
+      continue;
+    }
+    RegionMessage message;
+    memset(&message, 0, sizeof(message));
+    message.handoffs = handoffs[side].size();
+    message.ghosts = ghosts[side].size();
+    message.max_speed = speed;
+    ghosts_ += message.ghosts;
+
+    vector<char> & out = outgoing_[side];
+    out.resize(sizeof(message) + (message.handoffs + message.ghosts) * sizeof(EventRecord));
+    memcpy(&out[0], &message, sizeof(message));
+    memcpy(&out[sizeof(message)], handoffs[side].data(), message.handoffs * sizeof(EventRecord));
+    memcpy(&out[sizeof(message) + message.handoffs * sizeof(EventRecord)], ghosts[side].data(),
+           message.ghosts * sizeof(EventRecord));
+  }
+
+  if (!transfer()) {
+    return false;
+  }
+
+  neighbour_speed_ = 0.0f;
+  installs_.clear();
+  for (int side = 0; side < 2; side++) {
+    if (links_[side] == -1) {
+      continue;
+    }
+    RegionMessage message;
+    memcpy(&message, &incoming_[side][0], sizeof(message));
+    neighbour_speed_ = max(neighbour_speed_, message.max_speed);
+
+    EventRecord const * records = (EventRecord const *)&incoming_[side][sizeof(message)];
+    for (uint32_t k = 0; k < message.handoffs + message.ghosts; k++) {
+      receive(records[k], (k < message.handoffs) ? OWNED : GHOST);
+    }
+  }
+
+  // ghosts that were not sent again are out of reach
+  sort(ghost_ids_.begin(), ghost_ids_.end());
+  ghost_ids_.erase(unique(ghost_ids_.begin(), ghost_ids_.end()), ghost_ids_.end());
+  kept = 0;
+  for (int k = 0; k < ghost_ids_.size(); k++) {
+    int id = ghost_ids_[k];
+    if (roles_[id] != GHOST) {
+      continue;
+    }
+    if (ghost_windows_[id] != window_) {
+      dummyengine_.deactivate(id);
+      roles_[id] = ABSENT;
+      continue;
+    }
+    ghost_ids_[kept++] = id;
+  }
+  ghost_ids_.resize(kept);
+  dummyengine_.install(installs_, time);
+
+  window_++;
+  return true;
+}
+
+// A ghost or handed off object only gets its owner's event when that is
+// not its motion here already, because the owner's motion changed or this
+// engine changed it in a collision. The event is installed as it is, with
+// its own time, so the motion stays exactly the owner's however many
+// windows it lasts.
+void Region::receive(EventRecord const & record, Role role) {
+  CollisionEvent event;
+  unpackEvent(record, event);
+  int id = event.object();
+
+  EventRecord latest;
+  packEvent(dummyengine_.latestEvent(id), latest);
+  if (roles_[id] == ABSENT || memcmp(&latest, &record, sizeof(record)) != 0) {
+    installs_.push_back(event);
+  }
+
+  roles_[id] = role;
+  if (role == OWNED) {
+    owned_.push_back(id);
+  } else {
+    ghost_windows_[id] = window_;
+    ghost_ids_.push_back(id);
+  }
+}
+
+// Writes both outgoing messages while reading both incoming ones. One after
+// the other, two neighbours could each block writing to the other once a
+// message no longer fits in the socket buffer.
+bool Region::transfer() {
+  size_t sent[2] = { 0, 0 };
+  size_t received[2] = { 0, 0 };
+  bool sized[2] = { false, false };
+  for (int side = 0; side < 2; side++) {
+    incoming_[side].resize(sizeof(RegionMessage));
+  }
+
+  while (true) {
+    struct pollfd fds[2];
+    int sides[2];
+    int count = 0;
+    for (int side = 0; side < 2; side++) {
+      if (links_[side] == -1) {
+        continue;
+      }
+      short events = 0;
+      if (sent[side] < outgoing_[side].size()) {
+        events |= POLLOUT;
+      }
+      if (received[side] < incoming_[side].size()) {
+        events |= POLLIN;
+      }
+      if (events != 0) {
+        fds[count].fd = links_[side];
+        fds[count].events = events;
+        fds[count].revents = 0;
+        sides[count++] = side;
+      }
+    }
+    if (count == 0) {
+      return true;
+    }
+    if (poll(fds, count, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+
+    for (int k = 0; k < count; k++) {
+      int side = sides[k];
+      if (fds[k].revents & POLLOUT) {
+        ssize_t n = send(links_[side], &outgoing_[side][sent[side]],
+                         outgoing_[side].size() - sent[side], MSG_NOSIGNAL);
+        if (n < 0 && errno != EAGAIN && errno != EINTR) {
+          return false;
+        }
+        sent[side] += max(n, (ssize_t)0);
+      }
+      if (fds[k].revents & (POLLIN | POLLHUP | POLLERR)) {
+        ssize_t n = recv(links_[side], &incoming_[side][received[side]],
+                         incoming_[side].size() - received[side], 0);
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) {
+          return false;
+        }
+        received[side] += max(n, (ssize_t)0);
+        if (!sized[side] && received[side] == sizeof(RegionMessage)) {
+          RegionMessage message;
+          memcpy(&message, &incoming_[side][0], sizeof(message));
+          incoming_[side].resize(sizeof(message) +
+                                 (message.handoffs + message.ghosts) * sizeof(EventRecord));
+          sized[side] = true;
+        }
+      }
+    }
+  }
+}
+
+// fastest any point of an owned object moves, rotation included
+float Region::maxSpeed() const {
+  float speed = 0.0f;
+  for (int k = 0; k < owned_.size(); k++) {
+    CollisionEvent const & motion = (window_ == 0) ? scene_->events()[owned_[k]]
+                                                   : dummyengine_.latestEvent(owned_[k]);
+    speed = max(speed, glm::length(*motion.velocity()) +
+                       fabs(motion.angular_velocity()) * max_radius_);
+  }
+  return speed;
+}
+
+bool Region::simulate(Scene const & scene,
+                      int num_regions,
+                      BroadPhaseType broadphase,
+                      float until,
+                      float window,
+                      vector<CollisionEvent> & events) {
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  int n = scene.numObjects();
+
+  // boundaries at quantiles of x, so the slabs start out about as full
+  vector<float> xs;
+  for (int i = 0; i < n; i++) {
+    xs.push_back((*scene.events()[i].initial_coordinates()).x);
+  }
+  sort(xs.begin(), xs.end());
+  vector<float> bounds(num_regions + 1);
+  bounds[0] = -INFINITY;
+  bounds[num_regions] = INFINITY;
+  for (int k = 1; k < num_regions; k++) {
+    bounds[k] = (n > 0) ? xs[(long long)k * n / num_regions] : 0.0f;
+  }
+
+  // links[k] joins region k to region k + 1, reports[k] region k to here
+  vector<int> links(2 * (num_regions - 1));
+  vector<int> reports(2 * num_regions);
+  for (int k = 0; k + 1 < num_regions; k++) {
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, &links[2 * k]) != 0) {
+      perror("socketpair");
+      return false;
+    }
+  }
+  for (int k = 0; k < num_regions; k++) {
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, &reports[2 * k]) != 0) {
+      perror("socketpair");
+      return false;
+    }
+  }
+
+  // or the children would write out whatever is still buffered again
+  fflush(stdout);
+  fflush(stderr);
+  vector<pid_t> children;
+  for (int k = 0; k < num_regions; k++) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      perror("fork");
+      break;
+    }
+    if (pid == 0) {
+      int left = (k > 0) ? links[2 * (k - 1) + 1] : -1;
+      int right = (k + 1 < num_regions) ? links[2 * k] : -1;
+      int report = reports[2 * k + 1];
+      for (int i = 0; i < links.size(); i++) {
+        if (links[i] != left && links[i] != right) {
+          close(links[i]);
+        }
+      }
+      for (int i = 0; i < reports.size(); i++) {
+        if (reports[i] != report) {
+          close(reports[i]);
+        }
+      }
+
+      Region region(scene, k, bounds[k], bounds[k + 1], broadphase);
+      region.setLinks(left, right);
+      bool ok = region.run(until, window) && region.report(report);
+      _exit(ok ? 0 : 1);
+    }
+    children.push_back(pid);
+  }
+  for (int i = 0; i < links.size(); i++) {
+    close(links[i]);
+  }
+  for (int k = 0; k < num_regions; k++) {
+    close(reports[2 * k + 1]);
+  }
+
+  bool ok = children.size() == num_regions;
+  uint64_t total = 0;
+  events.assign(scene.events().begin(), scene.events().end());
+  for (int k = 0; k < children.size() && ok; k++) {
+    RegionReport report;
+    vector<EventRecord> records;
+    ok = readAll(reports[2 * k], &report, sizeof(report));
+    if (ok) {
+      records.resize(report.owned);
+      ok = readAll(reports[2 * k], records.data(), records.size() * sizeof(EventRecord));
+    }
+    if (!ok) {
+      fprintf(stderr, "region %d did not report back\n", k);
+      break;
+    }
+
+    for (int i = 0; i < records.size(); i++) {
+      CollisionEvent event;
+      unpackEvent(records[i], event);
+      if (event.object() >= 0 && event.object() < n) {
+        events[event.object()] = event;
+      }
+    }
+    total += report.events;
+    printf("region %d: x from %g to %g, %u objects, %llu events, %llu handed off, %llu ghosts sent\n",
+           k, bounds[k], bounds[k + 1], report.owned, (unsigned long long)report.events,
+           (unsigned long long)report.handoffs, (unsigned long long)report.ghosts);
+  }
+  for (int k = 0; k < num_regions; k++) {
+    close(reports[2 * k]);
+  }
+  for (int k = 0; k < children.size(); k++) {
+    int status;
+    waitpid(children[k], &status, 0);
+    ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  }
+
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  printf("%d regions, %llu events up to time %g in %.3f s", num_regions,
+         (unsigned long long)total, until, elapsed.count());
+  if (elapsed.count() > 0.0) {
+    printf(" (%.0f events/s)", total / elapsed.count());
+  }
+  printf("\n");
+  return ok;
+}
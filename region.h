@@ -0,0 +1,103 @@
+#ifndef REGION_H
+#define REGION_H
+#include <cstdint>
+#include <vector>
+#include "broadphase.h"
+#include "collisionevent.h"
+#include "dummyengine.h"
+#include "eventlog.h"
+#include "motionengine.h"
+#include "object.h"
+#include "scene.h"
+
+// What neighbours send each other at the start of every window, followed
+// by an EventRecord per handed off object and then per ghost.
+struct RegionMessage {
+  uint32_t handoffs;
+  uint32_t ghosts;
+  float max_speed;  // of any surface point of the sender's objects
+  uint32_t reserved;
+};
+
+// What a region sends back when it is done, followed by an EventRecord
+// with the latest event of each object it owns.
+struct RegionReport {
+  uint32_t owned;
+  uint32_t reserved;
+  uint64_t events;
+  uint64_t handoffs;
+  uint64_t ghosts;
+};
+
+// A slab of the world along x, simulated by a process of its own. Every
+// process has the whole scene, but only the objects a region owns and the
+// ghosts its neighbours send it ever get an event in its engine.
+//
+// Time advances in windows, and neighbours swap a message at the start of
+// each one, so no region gets more than a window ahead of the others. An
+// object whose center has left the slab is handed to the neighbour on that
+// side, and owned objects close enough to a boundary to reach anything
+// across it within the window are sent over as ghosts. A ghost follows the
+// motion its owner sends. A collision with a ghost only counts for the
+// owned object, the ghost gets its owner's motion back at the next window.
+// An interaction that goes through a ghost and a third object within one
+// window can therefore come out differently than in a single process, and
+// shorter windows make that rarer.
+class Region {
+  public:
+    Region(Scene const & scene, int index, float low, float high, BroadPhaseType broadphase);
+
+    // sockets to the neighbours, -1 where there is none
+    void setLinks(int left, int right);
+    bool run(float until, float window);
+    bool report(int fd) const;
+
+    // Splits the scene into slabs with about as many objects each and runs
+    // every one in a process of its own, connected over local sockets.
+    // events gets the latest event of every object at the end.
+    static bool simulate(Scene const & scene,
+                         int num_regions,
+                         BroadPhaseType broadphase,
+                         float until,
+                         float window,
+                         std::vector<CollisionEvent> & events);
+
+  private:
+    enum Role { ABSENT, OWNED, GHOST };
+
+    // the engine keeps pointers to objects_ and motionengine_
+    Region(Region const &);
+    Region & operator=(Region const &);
+
+    bool exchange(float time, float window);
+    void receive(EventRecord const & record, Role role);
+    bool transfer();
+    float maxSpeed() const;
+
+    Scene const * scene_;
+    std::vector<Object*> objects_;
+    MotionEngine motionengine_;
+    DummyEngine dummyengine_;
+    int index_;
+    float low_;
+    float high_;
+    int links_[2];  // left and right
+    float max_radius_;
+    float neighbour_speed_;
+
+    std::vector<uint8_t> roles_;
+    std::vector<int> ghost_windows_;  // window each ghost was last sent in
+    std::vector<CollisionEvent> installs_;  // received motion that is new here
+    int window_;
+
+    std::vector<int> owned_;
+    std::vector<int> ghost_ids_;
+    std::vector<char> outgoing_[2];
+    std::vector<char> incoming_[2];
+
+    uint64_t events_;
+    uint64_t handoffs_;
+    uint64_t ghosts_;
+};
+
+#endif
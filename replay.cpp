@@ -0,0 +1,45 @@
+#include "replay.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <glm/glm.hpp>
+#include "eventlogreader.h"
+#include "headless.h"
+#include "motionengine.h"
+
+using namespace std;
+
+Replay::Replay() { }
+
+Replay::Replay(EventLogReader & reader) {
+  reader_ = &reader;
+  dump_ = NULL;
+  interval_ = 0.0f;
+}
+
+void Replay::setDump(FILE * file, float interval) {
+  dump_ = file;
+  interval_ = interval;
+}
+
+void Replay::run(float time) {
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+  int frames = 0;
+  for (int k = 0; ; k++) {
+    float now = (interval_ > 0.0f) ? min(k * interval_, time) : time;
+    reader_->getPoses(now, motionengine_, poses_);
+    if (dump_ != NULL) {
+      Headless::writePoses(dump_, now, poses_);
+    }
+    frames++;
+    if (now >= time) {
+      break;
+    }
+  }
+
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  printf("%d frames up to time %g from %lld events in %.3f s\n",
+         frames, time, reader_->size(), elapsed.count());
+}
@@ -0,0 +1,29 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+#include <cstdio>
+#include <vector>
+#include <glm/glm.hpp>
+#include "eventlogreader.h"
+#include "motionengine.h"
+
+// Writes poses from an event log in the same format as a headless run,
+// looking them up instead of simulating them again.
+class Replay {
+  public:
+    Replay();
+    Replay(EventLogReader & reader);
+
+    // poses are written every interval of time, or only at the end if
+    // interval is 0
+    void setDump(FILE * file, float interval);
+    void run(float time);
+
+  private:
+    EventLogReader * reader_;
+    MotionEngine motionengine_;
+    FILE * dump_;
+    float interval_;
+    std::vector<glm::mat4> poses_;
+};
+
+#endif
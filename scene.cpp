@@ -0,0 +1,445 @@
+#include "scene.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "collisionevent.h"
+#include "cuboid.h"
+#include "object.h"
+#include "shape.h"
+#include "shaperegistry.h"
+
+#define SCENE_MAGIC "CDSCENE"
+#define SCENE_VERSION 1
+#define SHAPE_CUBOID 0
+#define MANTISSA_LIMIT 100000000000000000ULL  // digits past this only scale
+// the fewest bytes a line can take, with the blank before it
+#define MIN_SHAPE_TEXT 13   // " cuboid 1 1 1"
+#define MIN_OBJECT_TEXT 32  // sixteen one digit numbers
+
+static_assert(sizeof(SceneHeader) == 24, "scene header layout");
+static_assert(sizeof(SceneShapeRecord) == 16, "scene shape record layout");
+static_assert(sizeof(SceneObjectRecord) == 64, "scene object record layout");
+
+static const double POWERS_OF_TEN[23] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// The text is read in place from the mapping, so there are no strings or
+// line buffers, and nothing needs a terminating 0.
+
+static bool fail(char const * path, int line, char const * message) {
+  fprintf(stderr, "%s:%d: %s\n", path, line, message);
+  return false;
+}
+
+static bool isBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// whitespace and comments, counting lines for the error messages
+static void skipBlank(char const *& p, char const * end, int & line) {
+  while (p < end) {
+    if (*p == '\n') {
+      line++;
+      p++;
+    } else if (isBlank(*p)) {
+      p++;
+    } else if (*p == '#') {
+      while (p < end && *p != '\n') {
+        p++;
+      }
+    } else {
+      break;
+    }
+  }
+}
+
+static bool atTokenEnd(char const * p, char const * end) {
+  return p == end || isBlank(*p) || *p == '#';
+}
+
+static bool readWord(char const *& p, char const * end, int & line, char const * word) {
+  skipBlank(p, end, line);
+  size_t length = strlen(word);
+  if ((size_t)(end - p) < length || memcmp(p, word, length) != 0 ||
+      !atTokenEnd(p + length, end)) {
+    return false;
+  }
+  p += length;
+  return true;
+}
+
+static bool readCount(char const *& p, char const * end, int & line, long long & count) {
+  skipBlank(p, end, line);
+  char const * start = p;
+  count = 0;
+  while (p < end && isDigit(*p) && count < INT32_MAX) {
+    count = count * 10 + (*p - '0');
+    p++;
+  }
+  if (p == start || !atTokenEnd(p, end)) {
+    p = start;
+    return false;
+  }
+  return true;
+}
+
+// Decimal digits gathered into an integer and scaled by one power of ten,
+// which is exact enough for floats and far quicker than strtof.
+static bool readFloat(char const *& p, char const * end, int & line, float & value) {
+  skipBlank(p, end, line);
+  char const * start = p;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = (*p == '-');
+    p++;
+  }
+
+  uint64_t mantissa = 0;
+  int exponent = 0;
+  bool digits = false;
+  while (p < end && isDigit(*p)) {
+    if (mantissa < MANTISSA_LIMIT) {
+      mantissa = mantissa * 10 + (*p - '0');
+    } else {
+      exponent++;
+    }
+    digits = true;
+    p++;
+  }
+  if (p < end && *p == '.') {
+    p++;
+    while (p < end && isDigit(*p)) {
+      if (mantissa < MANTISSA_LIMIT) {
+        mantissa = mantissa * 10 + (*p - '0');
+        exponent--;
+      }
+      digits = true;
+      p++;
+    }
+  }
+  if (digits && p < end && (*p == 'e' || *p == 'E')) {
+    p++;
+    bool negative_exponent = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+      negative_exponent = (*p == '-');
+      p++;
+    }
+    int written = 0;
+    bool exponent_digits = false;
+    while (p < end && isDigit(*p)) {
+      if (written < 1000) {
+        written = written * 10 + (*p - '0');
+      }
+      exponent_digits = true;
+      p++;
+    }
+    digits = exponent_digits;
+    exponent += negative_exponent ? -written : written;
+  }
+  if (!digits || !atTokenEnd(p, end)) {
+    p = start;
+    return false;
+  }
+
+  double result = (double)mantissa;
+  if (exponent < 0) {
+    result /= (-exponent <= 22) ? POWERS_OF_TEN[-exponent] : pow(10.0, -exponent);
+  } else if (exponent > 0) {
+    result *= (exponent <= 22) ? POWERS_OF_TEN[exponent] : pow(10.0, exponent);
+  }
+  value = (float)(negative ? -result : result);
+  return true;
+}
+
+static bool readFloats(char const *& p, char const * end, int & line, float * values, int count) {
+  for (int i = 0; i < count; i++) {
+    if (!readFloat(p, end, line, values[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Scene::Scene() { }
+
+bool Scene::load(char const * path) {
+  clear();
+
+  int fd = ::open(path, O_RDONLY);
+  if (fd == -1) {
+    perror(path);
+    return false;
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0 || status.st_size == 0) {
+    fprintf(stderr, "%s: empty scene\n", path);
+    ::close(fd);
+    return false;
+  }
+  void * mapping = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    perror(path);
+    return false;
+  }
+  madvise(mapping, status.st_size, MADV_SEQUENTIAL);
+
+  char const * data = (char const *)mapping;
+  size_t size = status.st_size;
+  bool loaded;
+  if (size >= sizeof(SceneHeader) && memcmp(data, SCENE_MAGIC, sizeof(SCENE_MAGIC)) == 0) {
+    loaded = parseBinary(path, data, size);
+  } else {
+    loaded = parseText(path, data, size);
+  }
+  munmap(mapping, size);
+
+  if (!loaded) {
+    clear();
+  }
+  return loaded;
+}
+
+bool Scene::parseText(char const * path, char const * data, size_t size) {
+  char const * p = data;
+  char const * end = data + size;
+  int line = 1;
+
+  long long num_shapes;
+  if (!readWord(p, end, line, "shapes") || !readCount(p, end, line, num_shapes)) {
+    return fail(path, line, "expected shapes and how many");
+  }
+  // checked before reserving, so a wrong count can not ask for any size
+  if (num_shapes > (end - p) / MIN_SHAPE_TEXT) {
+    return fail(path, line, "more shapes counted than the file holds");
+  }
+  shapes_.reserve(num_shapes);
+  for (long long i = 0; i < num_shapes; i++) {
+    float dimensions[3];
+    if (!readWord(p, end, line, "cuboid")) {
+      return fail(path, line, "expected a cuboid");
+    }
+    if (!readFloats(p, end, line, dimensions, 3) ||
+        !(dimensions[0] > 0.0f && dimensions[1] > 0.0f && dimensions[2] > 0.0f)) {
+      return fail(path, line, "expected a width, height and depth above 0");
+    }
+    addShape(dimensions[0], dimensions[1], dimensions[2]);
+  }
+
+  long long num_objects;
+  if (!readWord(p, end, line, "objects") || !readCount(p, end, line, num_objects)) {
+    return fail(path, line, "expected objects and how many");
+  }
+  if (num_objects > (end - p) / MIN_OBJECT_TEXT) {
+    return fail(path, line, "more objects counted than the file holds");
+  }
+  reserve(num_objects);
+  for (long long i = 0; i < num_objects; i++) {
+    SceneObjectRecord record;
+    long long shape;
+    if (!readCount(p, end, line, shape) ||
+        !readFloat(p, end, line, record.mass) ||
+        !readFloats(p, end, line, record.position, 3) ||
+        !readFloats(p, end, line, record.orientation, 4) ||
+        !readFloats(p, end, line, record.axis_of_rotation, 3) ||
+        !readFloats(p, end, line, record.velocity, 3) ||
+        !readFloat(p, end, line, record.angular_velocity)) {
+      return fail(path, line, "expected a shape, mass, position, orientation, axis, "
+                              "velocity and angular velocity");
+    }
+    record.shape = (uint32_t)shape;
+    if (!addObject(record)) {
+      return fail(path, line, "unknown shape or a mass that is not above 0");
+    }
+  }
+
+  skipBlank(p, end, line);
+  if (p != end) {
+    return fail(path, line, "more than the objects that were counted");
+  }
+  return true;
+}
+
+bool Scene::parseBinary(char const * path, char const * data, size_t size) {
+  SceneHeader const * header = (SceneHeader const *)data;
+  if (header->version != SCENE_VERSION) {
+    fprintf(stderr, "%s: not a scene this version can read\n", path);
+    return false;
+  }
+  uint64_t expected = sizeof(SceneHeader) +
+                      (uint64_t)header->num_shapes * sizeof(SceneShapeRecord) +
+                      (uint64_t)header->num_objects * sizeof(SceneObjectRecord);
+  if (expected != size) {
+    fprintf(stderr, "%s: size does not match the counts in the header\n", path);
+    return false;
+  }
+
+  SceneShapeRecord const * shapes = (SceneShapeRecord const *)(header + 1);
+  shapes_.reserve(header->num_shapes);
+  for (uint32_t i = 0; i < header->num_shapes; i++) {
+    float const * dimensions = shapes[i].dimensions;
+    if (shapes[i].type != SHAPE_CUBOID ||
+        !(dimensions[0] > 0.0f && dimensions[1] > 0.0f && dimensions[2] > 0.0f)) {
+      fprintf(stderr, "%s: shape %u is not a cuboid with a size\n", path, i);
+      return false;
+    }
+    addShape(dimensions[0], dimensions[1], dimensions[2]);
+  }
+
+  SceneObjectRecord const * objects = (SceneObjectRecord const *)(shapes + header->num_shapes);
+  reserve(header->num_objects);
+  for (uint32_t i = 0; i < header->num_objects; i++) {
+    if (!addObject(objects[i])) {
+      fprintf(stderr, "%s: object %u has an unknown shape or no mass\n", path, i);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Scene::saveBinary(char const * path) const {
+  FILE * file = fopen(path, "wb");
+  if (file == NULL) {
+    perror(path);
+    return false;
+  }
+
+  SceneHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, SCENE_MAGIC, sizeof(SCENE_MAGIC));
+  header.version = SCENE_VERSION;
+  header.num_shapes = shapes_.size();
+  header.num_objects = objects_.size();
+  bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+
+  std::map<Shape const *, uint32_t> shape_index;
+  for (int i = 0; i < shapes_.size() && written; i++) {
+    SceneShapeRecord record;
+    record.type = SHAPE_CUBOID;
+    for (int k = 0; k < 3; k++) {
+      record.dimensions[k] = shapes_[i]->halfExtents()[k] * 2.0f;
+    }
+    shape_index[shapes_[i]] = i;
+    written = fwrite(&record, sizeof(record), 1, file) == 1;
+  }
+
+  for (int i = 0; i < objects_.size() && written; i++) {
+    CollisionEvent const & event = events_[i];
+    glm::quat const & orientation = *event.initial_orientation();
+    SceneObjectRecord record;
+    record.shape = shape_index[objects_[i]->shape()];
+    record.mass = objects_[i]->mass();
+    for (int k = 0; k < 3; k++) {
+      record.position[k] = (*event.initial_coordinates())[k];
+      record.axis_of_rotation[k] = (*event.axis_of_rotation())[k];
+      record.velocity[k] = (*event.velocity())[k];
+    }
+    record.orientation[0] = orientation.w;
+    record.orientation[1] = orientation.x;
+    record.orientation[2] = orientation.y;
+    record.orientation[3] = orientation.z;
+    record.angular_velocity = event.angular_velocity();
+    written = fwrite(&record, sizeof(record), 1, file) == 1;
+  }
+
+  if (fclose(file) != 0 || !written) {
+    fprintf(stderr, "%s: could not write the scene\n", path);
+    return false;
+  }
+  return true;
+}
+
+void Scene::makeDefault() {
+  clear();
+  addShape(1.0f, 1.0f, 1.0f);
+  addShape(2.0f, 2.0f, 2.0f);
+  reserve(2);
+  for (int i = 0; i < 2; i++) {
+    SceneObjectRecord record = {
+      (uint32_t)i,                         // shape
+      10.0f,                               // mass
+      { (i - 0.5f) * 4.0f, 0.0f, 0.0f },   // position
+      { 1.0f, 0.0f, 0.0f, 0.0f },          // orientation
+      { 1.0f, 0.0f, 0.0f },                // axis_of_rotation
+      { -4.0f * (i - 0.5f), 0.0f, 0.0f },  // velocity
+      0.0f                                 // angular_velocity
+    };
+    addObject(record);
+  }
+}
+
+int Scene::numObjects() const {
+  return objects_.size();
+}
+
+std::vector<Object*> const & Scene::objects() const {
+  return objects_;
+}
+
+std::vector<CollisionEvent> const & Scene::events() const {
+  return events_;
+}
+
+void Scene::clear() {
+  shapes_.clear();
+  cuboids_.clear();
+  objects_.clear();
+  events_.clear();
+}
+
+void Scene::reserve(long long num_objects) {
+  cuboids_.reserve(num_objects);
+  objects_.reserve(num_objects);
+  events_.reserve(num_objects);
+}
+
+void Scene::addShape(float x, float y, float z) {
+  shapes_.push_back(registry_.cuboid(x, y, z));
+}
+
+bool Scene::addObject(SceneObjectRecord const & record) {
+  // past the reserved space the cuboids would move under objects_
+  if (record.shape >= shapes_.size() || !(record.mass > 0.0f) ||
+      cuboids_.size() == cuboids_.capacity()) {
+    return false;
+  }
+
+  float const * q = record.orientation;
+  glm::quat orientation = glm::quat(q[0], q[1], q[2], q[3]);
+  float length = glm::length(orientation);
+  orientation = (length > 0.0f) ? glm::normalize(orientation) : glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+
+  float const * a = record.axis_of_rotation;
+  glm::vec3 axis = glm::vec3(a[0], a[1], a[2]);
+  length = glm::length(axis);
+  axis = (length > 0.0f) ? axis / length : glm::vec3(1.0f, 0.0f, 0.0f);
+
+  float const * c = record.position;
+  float const * v = record.velocity;
+  int id = cuboids_.size();
+  cuboids_.push_back(Cuboid(*shapes_[record.shape], record.mass));
+  objects_.push_back(&cuboids_.back());
+  events_.push_back(CollisionEvent(id,                               // object id
+                                   0.0f,                             // time
+                                   glm::vec3(c[0], c[1], c[2]),      // initial_coordinates
+                                   orientation,                      // initial_orientation
+                                   axis,                             // axis_of_rotation
+                                   glm::vec3(v[0], v[1], v[2]),      // velocity
+                                   record.angular_velocity));        // angular_velocity
+  return true;
+}
@@ -0,0 +1,86 @@
+#ifndef SCENE_H
+#define SCENE_H
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "collisionevent.h"
+#include "cuboid.h"
+#include "object.h"
+#include "shape.h"
+#include "shaperegistry.h"
+
+// The objects of a simulation and the motion each one starts with. A scene
+// file is either text:
+//
+//   # comments run to the end of the line
+//   shapes 2
+//   cuboid 1 1 1          # width height depth
+//   cuboid 2 2 2
+//   objects 2
+//   # shape mass  position  orientation w x y z  axis  velocity  angular velocity
+//   0 10  -2 0 0  1 0 0 0  1 0 0  2 0 0  0
+//   1 10   2 0 0  1 0 0 0  1 0 0 -2 0 0  0
+//
+// or the same lists in binary, a SceneHeader followed by the shape records
+// and then the object records. Either way the file is mapped into memory
+// and the counts up front size the storage once, so loading makes no
+// allocation per object.
+struct SceneHeader {
+  char magic[8];  // "CDSCENE" and a 0
+  uint32_t version;
+  uint32_t num_shapes;
+  uint32_t num_objects;
+  uint32_t reserved;
+};
+
+struct SceneShapeRecord {
+  uint32_t type;  // only cuboids so far
+  float dimensions[3];
+};
+
+struct SceneObjectRecord {
+  uint32_t shape;
+  float mass;
+  float position[3];
+  float orientation[4];  // w, x, y, z
+  float axis_of_rotation[3];
+  float velocity[3];
+  float angular_velocity;
+};
+
+class Scene {
+  public:
+    Scene();
+
+    // text or binary, told apart by the magic at the start
+    bool load(char const * path);
+    bool saveBinary(char const * path) const;
+    // the two cubes flying at each other that the simulation always had
+    void makeDefault();
+
+    int numObjects() const;
+    // Object i starts with events()[i] at time 0. Both stay where they are
+    // for as long as the scene lives.
+    std::vector<Object*> const & objects() const;
+    std::vector<CollisionEvent> const & events() const;
+
+  private:
+    Scene(Scene const &);  // objects point into cuboids_
+    Scene & operator=(Scene const &);
+
+    bool parseText(char const * path, char const * data, size_t size);
+    bool parseBinary(char const * path, char const * data, size_t size);
+    void clear();
+    void reserve(long long num_objects);
+    void addShape(float x, float y, float z);
+    // false if it names a shape that is not there or has no mass
+    bool addObject(SceneObjectRecord const & record);
+
+    ShapeRegistry registry_;
+    std::vector<Shape const *> shapes_;
+    std::vector<Cuboid> cuboids_;
+    std::vector<Object*> objects_;
+    std::vector<CollisionEvent> events_;
+};
+
+#endif
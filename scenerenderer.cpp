@@ -0,0 +1,93 @@
+#define GL_GLEXT_PROTOTYPES
+#include "scenerenderer.h"
+#include <vector>
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#include <OpenGL/glu.h>
+#else
+#include <GL/gl.h>
+#include <GL/glu.h>
+#endif
+#include <glm/glm.hpp>
+#include "instancedrenderer.h"
+#include "object.h"
+#include "state.h"
+
+SceneRenderer::SceneRenderer() {
+  objects_ = NULL;
+  instanced_ = false;
+}
+
+void SceneRenderer::init(std::vector<Object*> const & objects) {
+  objects_ = &objects;
+
+  //  Enable Z-buffer depth test
+  glClearDepth(1.0f);
+  glDepthFunc(GL_LEQUAL);
+  glEnable(GL_DEPTH_TEST);
+
+  instanced_ = renderer_.init(objects);
+}
+
+void SceneRenderer::reshape(int width, int height) {
+  glViewport (0, 0, (GLsizei) width, (GLsizei) height);
+  glMatrixMode(GL_PROJECTION);
+  glLoadIdentity();
+  gluPerspective(30.0, (GLfloat) width/(GLfloat) height, 0.1, 200.0);
+  glMatrixMode(GL_MODELVIEW);
+
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void SceneRenderer::draw(std::vector<glm::mat4> const & poses) {
+  glClearColor(255.0,255.0,255.0,1.0);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  glLoadIdentity(); // Reset transformations
+
+  // default camera position
+  glTranslatef(0., 0., -10.);
+
+  // default to showing the borders of triangles
+  glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+  //glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+  glEnable(GL_DEPTH_TEST); //enable the depth testing
+
+  if (poses.empty()) {
+    return;
+  }
+  if (instanced_) {
+    renderer_.draw(poses);
+  } else {
+    drawClientArrays(poses);
+  }
+}
+
+// For contexts without instancing, every object is its own draw call.
+void SceneRenderer::drawClientArrays(std::vector<glm::mat4> const & poses) {
+  states_.resize(poses.size());
+  for (int i = 0; i < states_.size(); i++) {
+    Object * object = (*objects_)[i];
+    states_[i].setVerts(*(object->verts()));
+    states_[i].setTris(*(object->tris()));
+    *states_[i].pose() = poses[i];
+  }
+
+  for (int i = 0; i < states_.size(); i++) {
+    State & state = states_[i];
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    glVertexPointer(4, GL_FLOAT, 0, state.verts());
+    glColorPointer(4, GL_FLOAT, 0, state.verts());
+
+    glPushMatrix();
+    glMultMatrixf((float*)state.pose());
+    glDrawElements(GL_TRIANGLES, 3 * (*objects_)[i]->numtris(), GL_UNSIGNED_INT, state.tris());
+    glPopMatrix();
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+  }
+}
@@ -0,0 +1,29 @@
+#ifndef SCENERENDERER_H
+#define SCENERENDERER_H
+#include <vector>
+#include <glm/glm.hpp>
+#include "instancedrenderer.h"
+#include "object.h"
+#include "state.h"
+
+// Camera, render state and drawing of the objects at given poses, shared
+// by the window and offscreen rendering. Needs a current context.
+class SceneRenderer {
+  public:
+    SceneRenderer();
+
+    void init(std::vector<Object*> const & objects);
+    void reshape(int width, int height);
+    // poses in object order, clears and draws the whole frame
+    void draw(std::vector<glm::mat4> const & poses);
+
+  private:
+    void drawClientArrays(std::vector<glm::mat4> const & poses);
+
+    std::vector<Object*> const * objects_;
+    std::vector<State> states_;
+    InstancedRenderer renderer_;
+    bool instanced_;  // otherwise one client array draw per object
+};
+
+#endif
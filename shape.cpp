@@ -0,0 +1,15 @@
+#include "shape.h"
+#include <vector>
+#include <glm/glm.hpp>
+
+Shape::Shape() { }
+
+Shape::Shape(std::vector<glm::vec4> const & verts,
+             std::vector<glm::highp_uvec3> const & tris,
+             glm::vec3 const & half_extents,
+             glm::mat3 const & unit_inertia) {
+  verts_ = verts;
+  tris_ = tris;
+  half_extents_ = half_extents;
+  unit_inertia_ = unit_inertia;
+}
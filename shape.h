@@ -0,0 +1,33 @@
+#ifndef SHAPE_H
+#define SHAPE_H
+#include <vector>
+#include <glm/glm.hpp>
+
+// Immutable geometry and mass properties shared by every body of the same
+// shape. Bodies only keep a pointer to one plus their own mass.
+class Shape {
+  public:
+    Shape();
+    Shape(std::vector<glm::vec4> const & verts,
+          std::vector<glm::highp_uvec3> const & tris,
+          glm::vec3 const & half_extents,
+          glm::mat3 const & unit_inertia);
+
+    glm::vec4 const * verts() const { return &verts_[0]; }
+    glm::highp_uvec3 const * tris() const { return &tris_[0]; }
+    int numverts() const { return verts_.size(); }
+    int numtris() const { return tris_.size(); }
+
+    // of the bounding box around the center, in the shape's own frame
+    glm::vec3 const & halfExtents() const { return half_extents_; }
+    // inertia tensor about the center for a mass of 1
+    glm::mat3 const & unitInertia() const { return unit_inertia_; }
+
+  private:
+    std::vector<glm::vec4> verts_;
+    std::vector<glm::highp_uvec3> tris_;
+    glm::vec3 half_extents_;
+    glm::mat3 unit_inertia_;
+};
+
+#endif
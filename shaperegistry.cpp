@@ -0,0 +1,54 @@
+#include "shaperegistry.h"
+#include <map>
+#include <tuple>
+#include <vector>
+#include <glm/glm.hpp>
+#include "shape.h"
+
+static const glm::highp_uvec3 CUBOID_TRIS[12] = {
+  { 0, 3, 1 },  { 0, 2, 3 },  { 4, 2, 0 },  { 4, 6, 2 },
+  { 5, 6, 4 },  { 5, 7, 6 },  { 1, 7, 5 },  { 1, 3, 7 },
+  { 0, 5, 4 },  { 0, 1, 5 },  { 2, 3, 7 },  { 2, 6, 7 }
+};
+
+ShapeRegistry::ShapeRegistry() { }
+
+Shape const * ShapeRegistry::cuboid(float x, float y, float z) {
+  std::tuple<float, float, float> key = std::make_tuple(x, y, z);
+  std::map<std::tuple<float, float, float>, Shape>::iterator found = cuboids_.find(key);
+  if (found != cuboids_.end()) {
+    return &found->second;
+  }
+
+  std::vector<glm::vec4> verts;
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 2; j++) {
+      for (int k = 0; k < 2; k++) {
+        verts.push_back(glm::vec4(x * (2.0*i - 1.0) / 2.0,
+                                  y * (2.0*j - 1.0) / 2.0,
+                                  z * (2.0*k - 1.0) / 2.0,
+                                  1.0f));
+      }
+    }
+  }
+  std::vector<glm::highp_uvec3> tris(CUBOID_TRIS, CUBOID_TRIS + 12);
+
+  // solid box of uniform density
+  glm::mat3 unit_inertia = glm::mat3(0.0f);
+  unit_inertia[0][0] = (y * y + z * z) / 12.0f;
+  unit_inertia[1][1] = (x * x + z * z) / 12.0f;
+  unit_inertia[2][2] = (x * x + y * y) / 12.0f;
+
+  Shape & shape = cuboids_[key];
+  shape = Shape(verts, tris, glm::vec3(x, y, z) * 0.5f, unit_inertia);
+  return &shape;
+}
+
+int ShapeRegistry::size() const {
+  return cuboids_.size();
+}
+
+ShapeRegistry & ShapeRegistry::shared() {
+  static ShapeRegistry registry;
+  return registry;
+}
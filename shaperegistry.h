@@ -0,0 +1,24 @@
+#ifndef SHAPEREGISTRY_H
+#define SHAPEREGISTRY_H
+#include <map>
+#include <tuple>
+#include "shape.h"
+
+// Hands out one Shape per distinct set of dimensions. Shapes live as long
+// as the registry and never move, so bodies can hold plain pointers to
+// them. Not thread safe, shapes are meant to be made while setting up.
+class ShapeRegistry {
+  public:
+    ShapeRegistry();
+
+    Shape const * cuboid(float x, float y, float z);
+    int size() const;
+
+    // the registry Cuboid uses when it is only given dimensions
+    static ShapeRegistry & shared();
+
+  private:
+    std::map<std::tuple<float, float, float>, Shape> cuboids_;
+};
+
+#endif
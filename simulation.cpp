@@ -2,45 +2,85 @@
 #include <cstdio>
 #include <vector>
 #include "viewer.h"
+#include "simulationthread.h"
+#include "snapshotbuffer.h"
+#include "broadphase.h"
+#include "eventlog.h"
+#include "frameencoder.h"
+#include "headless.h"
 #include "object.h"
-#include "cuboid.h"
+#include "scene.h"
 #include "dummyengine.h"
 #include "motionengine.h"
 #include "collisionevent.h"
+#ifndef HEADLESS
+#include "offscreen.h"
+#endif
+
+#define TIME_STEP 0.01f
+#define STEPS_PER_SECOND 60.0f
+#define END_TIME 100.0f
 
 using namespace std;
 
-Simulation::Simulation() {
-  Cuboid s_cube = Cuboid(1.0, 1.0, 1.0, 10.0);
-  Cuboid l_cube = Cuboid(2.0, 2.0, 2.0, 10.0);
-
-  objects = std::vector<Object*>();
-  objects.push_back(&s_cube); // i = 0
-  objects.push_back(&l_cube); // i = 1
-
-  CollisionEvent s_event = CollisionEvent(0,                            // object id
-                                          0.0,                          // time
-                                          glm::vec3(-1.0f, -1.0f, 0.0f),// initial_coordinates
-                                          glm::vec3(0.0f, 0.0f, 1.0f),  // initial_axis
-                                          1.0f,                         // initial_angle
-                                          glm::vec3(0.0f, 1.0f, 0.0f),  // axis_of_rotation
-                                          glm::vec3(1.0f, 1.0f, 0.0f),  // velocity
-                                          1.0f);                        // angular_velocity
-
-  CollisionEvent l_event = CollisionEvent(1,                            // object id
-                                          0.0,                          // time
-                                          glm::vec3(-1.0f, 1.0f, 0.0f), // initial_coordinates
-                                          glm::vec3(0.0f, 1.0f, 1.0f),  // initial_axis
-                                          1.0f,                         // initial_angle
-                                          glm::vec3(1.0f, 0.0f, 1.0f),  // axis_of_rotation
-                                          glm::vec3(1.0f, -1.0f, 0.0f), // velocity
-                                          1.0f);                        // angular_velocity
-
-  //std::vector<CollisionEvent> events = std::vector<CollisionEvent>();
-  dummyengine = DummyEngine(motionengine, objects);
-  //dummyengine.pushEvent(s_event);
-  //dummyengine.pushEvent(l_event);
-
-  Viewer viewer = Viewer(dummyengine);
+Simulation::Simulation(Scene const & scene) : Simulation(scene, AABB_TREE) { }
+
+Simulation::Simulation(Scene const & scene, BroadPhaseType broadphase) {
+  checkpoint_path = NULL;
+  checkpoint_interval = 0.0f;
+  objects = scene.objects();
+  dummyengine = DummyEngine(motionengine, objects, scene.events());
+  dummyengine.setBroadPhase(broadphase);
+}
+
+void Simulation::setThreads(int threads) {
+  dummyengine.setThreads(threads);
+}
+
+bool Simulation::setEventLog(char const * path, bool quantized) {
+  if (!eventlog.open(path, objects.size(), quantized)) {
+    return false;
+  }
+  dummyengine.setEventLog(&eventlog);
+  return true;
+}
+
+// carries on from the checkpoint instead of the start of the scene
+bool Simulation::resume(char const * checkpoint) {
+  return dummyengine.restoreCheckpoint(checkpoint);
+}
+
+void Simulation::setCheckpoint(char const * path, float interval) {
+  checkpoint_path = path;
+  checkpoint_interval = interval;
+}
+
+void Simulation::run() {
+#ifdef HEADLESS
+  fprintf(stderr, "built without a viewer, use --headless\n");
+#else
+  // the viewer only ever sees what the simulation thread publishes
+  simulationthread.start(dummyengine, snapshots, TIME_STEP, STEPS_PER_SECOND, END_TIME);
+  viewer = Viewer(objects, snapshots, simulationthread, END_TIME);
   viewer.initGlut(0, NULL);
+#endif
+}
+
+void Simulation::runHeadless(float time, int max_events, FILE * dump, float interval) {
+  Headless headless = Headless(dummyengine);
+  headless.setDump(dump, interval);
+  headless.setCheckpoint(checkpoint_path, checkpoint_interval);
+  headless.run(time, max_events);
+}
+
+// frames at the same steps of simulated time the viewer shows
+bool Simulation::runOffscreen(FrameEncoder::Format format, char const * path,
+                              int width, int height, float time) {
+#ifdef HEADLESS
+  fprintf(stderr, "built without rendering, use the full build to export frames\n");
+  return false;
+#else
+  Offscreen offscreen = Offscreen(dummyengine, objects);
+  return offscreen.run(format, path, width, height, TIME_STEP, time);
+#endif
 }
@@ -1,20 +1,44 @@
 #ifndef SIMULATION_H
 #define SIMULATION_H
+#include <cstdio>
 #include <vector>
+#include "broadphase.h"
+#include "eventlog.h"
+#include "frameencoder.h"
 #include "object.h"
+#include "scene.h"
 #include "viewer.h"
+#include "simulationthread.h"
+#include "snapshotbuffer.h"
 #include "motionengine.h"
 #include "dummyengine.h"
 #include "collisionevent.h"
 
 class Simulation {
   public:
-    Simulation();
+    Simulation(Scene const & scene);
+    Simulation(Scene const & scene, BroadPhaseType broadphase);
+    void setThreads(int threads);
+    bool setEventLog(char const * path, bool quantized);
+    bool resume(char const * checkpoint);
+    // headless runs only
+    void setCheckpoint(char const * path, float interval);
+    void run();
+    void runHeadless(float time, int max_events, FILE * dump, float interval);
+    bool runOffscreen(FrameEncoder::Format format, char const * path,
+                      int width, int height, float time);
   private:
     std::vector<Object*> objects;
+#ifndef HEADLESS
     Viewer viewer;
+    SnapshotBuffer snapshots;
+    SimulationThread simulationthread;
+#endif
     MotionEngine motionengine;
     DummyEngine dummyengine;
+    EventLog eventlog;
+    char const * checkpoint_path;
+    float checkpoint_interval;
 };
 
 
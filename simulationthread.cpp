@@ -0,0 +1,82 @@
+#include "simulationthread.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "dummyengine.h"
+#include "snapshotbuffer.h"
+
+using namespace std;
+
+SimulationThread::SimulationThread() {
+  dummyengine_ = NULL;
+  snapshots_ = NULL;
+  stop_.store(false);
+  seek_.store(-1.0f);
+}
+
+SimulationThread::~SimulationThread() {
+  stop();
+}
+
+void SimulationThread::start(DummyEngine & dummyengine,
+                             SnapshotBuffer & snapshots,
+                             float step,
+                             float step_rate,
+                             float until) {
+  stop();
+  dummyengine_ = &dummyengine;
+  snapshots_ = &snapshots;
+  stop_.store(false);
+  seek_.store(-1.0f);
+  thread_ = thread(&SimulationThread::run, this, step, step_rate, until);
+}
+
+void SimulationThread::stop() {
+  stop_.store(true);
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void SimulationThread::seek(float time) {
+  seek_.store(max(time, 0.0f));
+}
+
+void SimulationThread::run(float step, float step_rate, float until) {
+  chrono::steady_clock::time_point next = chrono::steady_clock::now();
+  chrono::duration<double> interval(1.0 / step_rate);
+
+  float start = dummyengine_->time();  // after 0 when resumed from a checkpoint
+  float published = -1.0f;
+  int k = 0;
+  while (!stop_.load()) {
+    float target = seek_.exchange(-1.0f);
+    if (target >= 0.0f) {
+      start = min(target, until);
+      k = 0;
+      published = -1.0f;
+    }
+
+    // paused once at until, the steps only carry on after a seek
+    float time = min(start + k * step, until);
+    if (time != published) {
+      Snapshot & snapshot = snapshots_->back();
+      snapshot.time = time;
+      dummyengine_->getPoses(time, snapshot.poses);
+      snapshots_->publish();
+      published = time;
+    }
+    if (time < until) {
+      k++;
+    }
+
+    next += chrono::duration_cast<chrono::steady_clock::duration>(interval);
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    if (next < now) {
+      // late, so carry on from here rather than rushing to catch up
+      next = now;
+    }
+    this_thread::sleep_until(next);
+  }
+}
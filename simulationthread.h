@@ -0,0 +1,40 @@
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+#include <atomic>
+#include <thread>
+#include "dummyengine.h"
+#include "snapshotbuffer.h"
+
+// Runs the engine on a thread of its own and publishes the poses every
+// step of simulated time, so whoever draws them never waits for the engine
+// and the engine never waits for them.
+class SimulationThread {
+  public:
+    SimulationThread();
+    ~SimulationThread();
+
+    // Steps from 0 to until, publishing step_rate steps per second of real
+    // time, the last one at exactly until, and then waits there for a seek.
+    // Falls behind instead of skipping steps when the engine can not keep up.
+    void start(DummyEngine & dummyengine,
+               SnapshotBuffer & snapshots,
+               float step,
+               float step_rate,
+               float until);
+    void stop();
+
+    // Carries on stepping from time instead, earlier or later. Earlier
+    // times come from the engine's timelines without simulating again.
+    void seek(float time);
+
+  private:
+    void run(float step, float step_rate, float until);
+
+    DummyEngine * dummyengine_;
+    SnapshotBuffer * snapshots_;
+    std::thread thread_;
+    std::atomic<bool> stop_;
+    std::atomic<float> seek_;  // negative when there is nothing to seek to
+};
+
+#endif
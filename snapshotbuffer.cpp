@@ -0,0 +1,39 @@
+#include "snapshotbuffer.h"
+#include <atomic>
+
+SnapshotBuffer::SnapshotBuffer() {
+  back_ = 0;
+  middle_.store(1);
+  front_ = 2;
+  acquired_ = false;
+  for (int i = 0; i < 3; i++) {
+    buffers_[i].time = 0.0f;
+  }
+}
+
+Snapshot & SnapshotBuffer::back() {
+  return buffers_[back_];
+}
+
+// The exchange releases the writes to the back buffer to whoever picks it
+// up next and hands us whichever buffer was in the middle.
+void SnapshotBuffer::publish() {
+  back_ = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel) & INDEX;
+}
+
+bool SnapshotBuffer::acquire() {
+  if ((middle_.load(std::memory_order_relaxed) & FRESH) == 0) {
+    return false;
+  }
+  front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+  acquired_ = true;
+  return true;
+}
+
+Snapshot const & SnapshotBuffer::front() const {
+  return buffers_[front_];
+}
+
+bool SnapshotBuffer::empty() const {
+  return !acquired_;
+}
@@ -0,0 +1,43 @@
+#ifndef SNAPSHOTBUFFER_H
+#define SNAPSHOTBUFFER_H
+#include <atomic>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Poses of every object at one point in time.
+struct Snapshot {
+  float time;
+  std::vector<glm::mat4> poses;
+};
+
+// Triple buffer handing snapshots from one writer thread to one reader
+// thread without either of them ever waiting. The writer fills its back
+// buffer and swaps it with the middle one, the reader swaps its front
+// buffer with the middle one whenever something newer was published there.
+// Snapshots the reader never got to are simply overwritten.
+class SnapshotBuffer {
+  public:
+    SnapshotBuffer();
+
+    // writer side
+    Snapshot & back();
+    void publish();
+
+    // Reader side. Returns whether front changed, it keeps showing the last
+    // snapshot otherwise.
+    bool acquire();
+    Snapshot const & front() const;
+    bool empty() const;  // nothing acquired yet
+
+  private:
+    const static int FRESH = 4;  // set on middle_ when the writer published since
+    const static int INDEX = 3;  // the reader last swapped
+
+    Snapshot buffers_[3];
+    std::atomic<int> middle_;
+    int back_;   // only touched by the writer
+    int front_;  // only touched by the reader
+    bool acquired_;
+};
+
+#endif
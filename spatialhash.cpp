@@ -0,0 +1,195 @@
+#include "spatialhash.h"
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include "aabb.h"
+#include "pool.h"
+
+// room for the next pointer and a cached hash as well
+#define NODE_SIZE (2 * sizeof(void *) + sizeof(std::pair<long long const, int>))
+// Beyond this an object goes on the oversize list, so a fast mover costs
+// a list entry rather than a cell for every step of its sweep.
+#define MAX_CELLS 512
+
+SpatialHash::SpatialHash() : SpatialHash(1.0f) { }
+
+SpatialHash::SpatialHash(float cell_size)
+  : nodes_(NODE_SIZE),
+    cell_map_(0, std::hash<long long>(), std::equal_to<long long>(),
+              PoolAllocator<std::pair<long long const, int> >(&nodes_)) {
+  free_entries_ = -1;
+  query_ = 0;
+  cell_size_ = cell_size;
+}
+
+void SpatialHash::update(int object_id, AABB const & box) {
+  if ((int)boxes_.size() <= object_id) {
+    boxes_.resize(object_id + 1);
+    lower_cells_.resize(object_id + 1);
+    upper_cells_.resize(object_id + 1);
+    inserted_.resize(object_id + 1, false);
+    marks_.resize(object_id + 1, -1);
+    oversize_index_.resize(object_id + 1, -1);
+  }
+  boxes_[object_id] = box;
+
+  glm::ivec3 lower = cellOf(box.lower());
+  glm::ivec3 upper = cellOf(box.upper());
+  if (inserted_[object_id]) {
+    if (lower == lower_cells_[object_id] && upper == upper_cells_[object_id]) {
+      return;
+    }
+    erase(object_id);
+  }
+  lower_cells_[object_id] = lower;
+  upper_cells_[object_id] = upper;
+  insert(object_id);
+}
+
+void SpatialHash::query(int object_id, std::vector<int> & candidates) {
+  if ((int)boxes_.size() <= object_id || !inserted_[object_id]) {
+    return;
+  }
+  query_++;
+  marks_[object_id] = query_;
+
+  // An oversize object spanning more cells than there are objects checks
+  // every object instead. Everything else checks the cells it spans.
+  if (oversize_index_[object_id] != -1 && numCells(object_id) > (long long)boxes_.size()) {
+    for (int other = 0; other < (int)boxes_.size(); other++) {
+      if (inserted_[other]) {
+        consider(object_id, other, candidates);
+      }
+    }
+    return;
+  }
+  glm::ivec3 const & lower = lower_cells_[object_id];
+  glm::ivec3 const & upper = upper_cells_[object_id];
+  for (int x = lower.x; x <= upper.x; x++) {
+    for (int y = lower.y; y <= upper.y; y++) {
+      for (int z = lower.z; z <= upper.z; z++) {
+        CellMap::const_iterator cell = cell_map_.find(key(x, y, z));
+        if (cell == cell_map_.end()) {
+          continue;
+        }
+        for (int entry = cells_[cell->second].first; entry != -1; entry = entries_[entry].next) {
+          consider(object_id, entries_[entry].object, candidates);
+        }
+      }
+    }
+  }
+  for (int i = 0; i < (int)oversized_.size(); i++) {
+    consider(object_id, oversized_[i], candidates);
+  }
+}
+
+void SpatialHash::consider(int object_id, int other, std::vector<int> & candidates) {
+  if (marks_[other] != query_ && boxes_[object_id].overlaps(boxes_[other])) {
+    marks_[other] = query_;
+    candidates.push_back(other);
+  }
+}
+
+// Only the low 21 bits of each axis are kept, so cells 2^21 apart share a
+// key and an object list. That costs no more than a few extra overlap
+// tests, as every candidate is checked against the box anyway.
+long long SpatialHash::key(int x, int y, int z) const {
+  return ((long long)(x & 0x1FFFFF) << 42) | ((long long)(y & 0x1FFFFF) << 21) | (z & 0x1FFFFF);
+}
+
+glm::ivec3 SpatialHash::cellOf(glm::vec3 const & point) const {
+  return glm::ivec3((int)std::floor(point.x / cell_size_),
+                    (int)std::floor(point.y / cell_size_),
+                    (int)std::floor(point.z / cell_size_));
+}
+
+long long SpatialHash::numCells(int object_id) const {
+  glm::ivec3 const & lower = lower_cells_[object_id];
+  glm::ivec3 const & upper = upper_cells_[object_id];
+  return (long long)(upper.x - lower.x + 1) * (upper.y - lower.y + 1) * (upper.z - lower.z + 1);
+}
+
+void SpatialHash::insert(int object_id) {
+  inserted_[object_id] = true;
+  if (numCells(object_id) > MAX_CELLS) {
+    oversize_index_[object_id] = oversized_.size();
+    oversized_.push_back(object_id);
+    return;
+  }
+
+  glm::ivec3 const & lower = lower_cells_[object_id];
+  glm::ivec3 const & upper = upper_cells_[object_id];
+  for (int x = lower.x; x <= upper.x; x++) {
+    for (int y = lower.y; y <= upper.y; y++) {
+      for (int z = lower.z; z <= upper.z; z++) {
+        long long cell_key = key(x, y, z);
+        CellMap::iterator cell = cell_map_.find(cell_key);
+        if (cell == cell_map_.end()) {
+          int index = cells_.size();
+          if (free_cells_.empty()) {
+            cells_.push_back(Cell());
+          } else {
+            index = free_cells_.back();
+            free_cells_.pop_back();
+          }
+          cells_[index].first = -1;
+          cell = cell_map_.insert(std::make_pair(cell_key, index)).first;
+        }
+
+        int entry = free_entries_;
+        if (entry == -1) {
+          entry = entries_.size();
+          entries_.push_back(Entry());
+        } else {
+          free_entries_ = entries_[entry].next;
+        }
+        entries_[entry].object = object_id;
+        entries_[entry].next = cells_[cell->second].first;
+        cells_[cell->second].first = entry;
+      }
+    }
+  }
+}
+
+void SpatialHash::remove(int object_id) {
+  if ((int)boxes_.size() > object_id && inserted_[object_id]) {
+    erase(object_id);
+  }
+}
+
+void SpatialHash::erase(int object_id) {
+  inserted_[object_id] = false;
+  int index = oversize_index_[object_id];
+  if (index != -1) {
+    oversized_[index] = oversized_.back();
+    oversize_index_[oversized_[index]] = index;
+    oversized_.pop_back();
+    oversize_index_[object_id] = -1;
+    return;
+  }
+
+  glm::ivec3 const & lower = lower_cells_[object_id];
+  glm::ivec3 const & upper = upper_cells_[object_id];
+  for (int x = lower.x; x <= upper.x; x++) {
+    for (int y = lower.y; y <= upper.y; y++) {
+      for (int z = lower.z; z <= upper.z; z++) {
+        CellMap::iterator cell = cell_map_.find(key(x, y, z));
+        int * link = &cells_[cell->second].first;
+        while (entries_[*link].object != object_id) {
+          link = &entries_[*link].next;
+        }
+        int entry = *link;
+        *link = entries_[entry].next;
+        entries_[entry].next = free_entries_;
+        free_entries_ = entry;
+        if (cells_[cell->second].first == -1) {
+          free_cells_.push_back(cell->second);
+          cell_map_.erase(cell);
+        }
+      }
+    }
+  }
+}
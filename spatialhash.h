@@ -0,0 +1,66 @@
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include "aabb.h"
+#include "broadphase.h"
+#include "pool.h"
+
+// Uniform grid hashed on integer cell coordinates. Works best when the cell
+// size is close to the size of most objects. Each cell lists its objects
+// through entries that all share one array, and objects moving from cell
+// to cell reuse the entries, cells and map nodes that were let go, so
+// allocations only grow with the number of cells in use.
+class SpatialHash : public BroadPhase {
+  public:
+    SpatialHash();
+    SpatialHash(float cell_size);
+
+    virtual void update(int object_id, AABB const & box);
+    virtual void remove(int object_id);
+    virtual void query(int object_id, std::vector<int> & candidates);
+
+  private:
+    struct Cell {
+      int first;  // entry, -1 at the end of the list
+    };
+    struct Entry {
+      int object;
+      int next;  // entry, in the cell's list or the free list
+    };
+    // key to index into cells_
+    typedef std::unordered_map<long long, int, std::hash<long long>, std::equal_to<long long>,
+                               PoolAllocator<std::pair<long long const, int> > > CellMap;
+
+    // the map points into nodes_
+    SpatialHash(SpatialHash const &);
+    SpatialHash & operator=(SpatialHash const &);
+
+    long long key(int x, int y, int z) const;
+    glm::ivec3 cellOf(glm::vec3 const & point) const;
+    long long numCells(int object_id) const;
+    void consider(int object_id, int other, std::vector<int> & candidates);
+    void insert(int object_id);
+    void erase(int object_id);
+
+    Pool nodes_;
+    CellMap cell_map_;
+    std::vector<Cell> cells_;
+    std::vector<int> free_cells_;  // emptied
+    std::vector<Entry> entries_;
+    int free_entries_;
+    std::vector<AABB> boxes_;
+    std::vector<glm::ivec3> lower_cells_;
+    std::vector<glm::ivec3> upper_cells_;
+    std::vector<bool> inserted_;
+    std::vector<int> marks_;  // last query each object was reported in
+    std::vector<int> oversized_;  // objects spanning too many cells to insert
+    std::vector<int> oversize_index_;  // into oversized_, -1 if in the cells
+    int query_;
+    float cell_size_;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#include "supportmapping.h"
+#include <algorithm>
+#include <vector>
+#include <glm/glm.hpp>
+#include "object.h"
+
+SupportMapping::SupportMapping() {
+  verts_ = NULL;
+  numverts_ = 0;
+}
+
+SupportMapping::SupportMapping(Object const & object) {
+  verts_ = object.verts();
+  numverts_ = object.numverts();
+
+  std::vector<std::vector<int> > adjacency(numverts_);
+  glm::highp_uvec3 const * tris = object.tris();
+  for (int i = 0; i < object.numtris(); i++) {
+    for (int j = 0; j < 3; j++) {
+      adjacency[tris[i][j]].push_back(tris[i][(j + 1) % 3]);
+      adjacency[tris[i][(j + 1) % 3]].push_back(tris[i][j]);
+    }
+  }
+
+  offsets_.push_back(0);
+  for (int i = 0; i < numverts_; i++) {
+    std::sort(adjacency[i].begin(), adjacency[i].end());
+    adjacency[i].erase(std::unique(adjacency[i].begin(), adjacency[i].end()), adjacency[i].end());
+    neighbors_.insert(neighbors_.end(), adjacency[i].begin(), adjacency[i].end());
+    offsets_.push_back(neighbors_.size());
+  }
+}
+
+glm::vec3 SupportMapping::support(glm::vec3 const & direction, int & start) const {
+  if (numverts_ <= SCAN_VERTS) {
+    start = 0;
+    float best = glm::dot(glm::vec3(verts_[0]), direction);
+    for (int i = 1; i < numverts_; i++) {
+      float projection = glm::dot(glm::vec3(verts_[i]), direction);
+      if (projection > best) {
+        best = projection;
+        start = i;
+      }
+    }
+    return glm::vec3(verts_[start]);
+  }
+
+  // on a convex mesh the first vertex with no better neighbor is the furthest
+  int current = (start >= 0 && start < numverts_) ? start : 0;
+  float best = glm::dot(glm::vec3(verts_[current]), direction);
+  int next = current;
+  do {
+    current = next;
+    for (int i = offsets_[current]; i < offsets_[current + 1]; i++) {
+      float projection = glm::dot(glm::vec3(verts_[neighbors_[i]]), direction);
+      if (projection > best) {
+        best = projection;
+        next = neighbors_[i];
+      }
+    }
+  } while (next != current);
+
+  start = current;
+  return glm::vec3(verts_[current]);
+}
@@ -0,0 +1,28 @@
+#ifndef SUPPORTMAPPING_H
+#define SUPPORTMAPPING_H
+#include <vector>
+#include <glm/glm.hpp>
+#include "object.h"
+
+// Support function of a convex Object. The vertex adjacency is built from
+// tris() once, so finding the furthest vertex in a direction is a hill climb
+// from a nearby vertex instead of a scan over all of them.
+class SupportMapping {
+  public:
+    SupportMapping();
+    SupportMapping(Object const & object);
+
+    // furthest vertex in the object's own frame, start is the vertex to
+    // climb from and is updated to the result
+    glm::vec3 support(glm::vec3 const & direction, int & start) const;
+
+  private:
+    const static int SCAN_VERTS = 16;  // below this a plain scan is cheaper
+
+    glm::vec4 const * verts_;
+    int numverts_;
+    std::vector<int> offsets_;    // neighbors of vertex i are
+    std::vector<int> neighbors_;  // neighbors_[offsets_[i]..offsets_[i + 1]]
+};
+
+#endif
@@ -0,0 +1,131 @@
+#include "sweepandprune.h"
+#include <algorithm>
+#include <vector>
+#include <glm/glm.hpp>
+#include "aabb.h"
+
+// switching axes re-sorts everything, so only for a clearly better one
+#define AXIS_SWITCH_RATIO 1.5
+
+SweepAndPrune::SweepAndPrune() {
+  axis_ = 0;
+  max_extent_ = 0.0f;
+  for (int i = 0; i < 3; i++) {
+    sum_[i] = 0.0;
+    sum_squares_[i] = 0.0;
+  }
+  count_ = 0;
+}
+
+void SweepAndPrune::update(int object_id, AABB const & box) {
+  while ((int)boxes_.size() <= object_id) {
+    positions_.push_back(order_.size());
+    order_.push_back(boxes_.size());
+    boxes_.push_back(AABB());
+  }
+  place(object_id, box);
+  chooseAxis();
+}
+
+// an empty box overlaps nothing and sorts to the end
+void SweepAndPrune::remove(int object_id) {
+  if ((int)boxes_.size() > object_id) {
+    place(object_id, AABB());
+  }
+}
+
+void SweepAndPrune::query(int object_id, std::vector<int> & candidates) {
+  if ((int)boxes_.size() <= object_id) {
+    return;
+  }
+
+  // no box starting further back than the widest one can reach this one
+  AABB const & box = boxes_[object_id];
+  float from = box.lower()[axis_] - max_extent_;
+  int first = std::lower_bound(order_.begin(), order_.end(), from, [this](int id, float value) {
+    return key(id) < value;
+  }) - order_.begin();
+
+  for (int i = first; i < (int)order_.size(); i++) {
+    AABB const & other = boxes_[order_[i]];
+    if (other.lower()[axis_] > box.upper()[axis_]) {
+      break;
+    }
+    if (order_[i] != object_id && box.overlaps(other)) {
+      candidates.push_back(order_[i]);
+    }
+  }
+}
+
+void SweepAndPrune::place(int object_id, AABB const & box) {
+  AABB & old = boxes_[object_id];
+  if (old.lower().x <= old.upper().x) {
+    glm::vec3 center = old.center();
+    for (int i = 0; i < 3; i++) {
+      sum_[i] -= center[i];
+      sum_squares_[i] -= (double)center[i] * center[i];
+    }
+    count_--;
+  }
+  old = box;
+  if (box.lower().x <= box.upper().x) {
+    glm::vec3 center = box.center();
+    for (int i = 0; i < 3; i++) {
+      sum_[i] += center[i];
+      sum_squares_[i] += (double)center[i] * center[i];
+    }
+    count_++;
+    max_extent_ = std::max(max_extent_, box.upper()[axis_] - box.lower()[axis_]);
+  }
+  move(object_id);
+}
+
+// insertion sort of a single entry, since boxes rarely move far between updates
+void SweepAndPrune::move(int object_id) {
+  int i = positions_[object_id];
+  float value = key(object_id);
+  while (i > 0 && key(order_[i - 1]) > value) {
+    order_[i] = order_[i - 1];
+    positions_[order_[i]] = i;
+    i--;
+  }
+  while (i + 1 < (int)order_.size() && key(order_[i + 1]) < value) {
+    order_[i] = order_[i + 1];
+    positions_[order_[i]] = i;
+    i++;
+  }
+  order_[i] = object_id;
+  positions_[object_id] = i;
+}
+
+// sweep along the axis the boxes are most spread out on
+void SweepAndPrune::chooseAxis() {
+  if (count_ == 0) {
+    return;
+  }
+  double variance[3];
+  int axis = axis_;
+  for (int i = 0; i < 3; i++) {
+    variance[i] = sum_squares_[i] - sum_[i] * sum_[i] / count_;
+    if (variance[i] > variance[axis]) {
+      axis = i;
+    }
+  }
+  if (axis == axis_ || variance[axis] < AXIS_SWITCH_RATIO * variance[axis_]) {
+    return;
+  }
+
+  axis_ = axis;
+  std::sort(order_.begin(), order_.end(), [this](int a, int b) {
+    return key(a) < key(b);
+  });
+  max_extent_ = 0.0f;
+  for (int i = 0; i < (int)order_.size(); i++) {
+    positions_[order_[i]] = i;
+    max_extent_ = std::max(max_extent_, boxes_[i].upper()[axis_] - boxes_[i].lower()[axis_]);
+  }
+}
+
+float SweepAndPrune::key(int object_id) const {
+  return boxes_[object_id].lower()[axis_];
+}
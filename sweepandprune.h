@@ -0,0 +1,35 @@
+#ifndef SWEEPANDPRUNE_H
+#define SWEEPANDPRUNE_H
+#include <vector>
+#include "aabb.h"
+#include "broadphase.h"
+
+// Sort-and-sweep over world space boxes. Each update moves just that box to
+// its place in the order, which for temporally coherent scenes is only a
+// few steps, and a query binary searches for where its sweep starts.
+class SweepAndPrune : public BroadPhase {
+  public:
+    SweepAndPrune();
+
+    virtual void update(int object_id, AABB const & box);
+    virtual void remove(int object_id);
+    virtual void query(int object_id, std::vector<int> & candidates);
+
+  private:
+    void place(int object_id, AABB const & box);
+    void move(int object_id);
+    void chooseAxis();
+    float key(int object_id) const;
+
+    std::vector<AABB> boxes_;
+    std::vector<int> order_;  // object ids sorted by lower bound on axis_
+    std::vector<int> positions_;  // of each object in order_
+    int axis_;
+    float max_extent_;  // of any box on axis_ since the last full sort
+    // of the box centers, for picking the axis they are most spread out on
+    double sum_[3];
+    double sum_squares_[3];
+    int count_;
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+#include <glm/glm.hpp>
+#include "broadphase.h"
+#include "collisionevent.h"
+#include "dummyengine.h"
+#include "motionengine.h"
+#include "profiler.h"
+#include "region.h"
+#include "scene.h"
+
+#define GRID 6  // objects along each side of the test scene
+#define SPACING 2.5f
+#define WARMUP_TIME 5.0f
+#define RUN_TIME 5.0f
+// Once warmed up, the only allocations left should be new slabs for the
+// timelines, one per 64 KB of events, and the odd vector that grows past
+// its largest size so far.
+#define EVENTS_PER_ALLOCATION 256
+#define ALLOCATION_SLACK 32
+#define REGIONS_TIME 10.0f
+#define REGIONS_TOLERANCE 1e-3f  // furthest an object may end up from where it should
+#define MASS_TIME 3.0f
+#define MASS_TOLERANCE 1e-4f
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool ok, char const * name, char const * detail) {
+  printf("%s %s%s%s\n", ok ? "ok  " : "FAIL", name, detail[0] != '\0' ? ": " : "", detail);
+  if (!ok) {
+    failures++;
+  }
+}
+
+// Loads what write puts in a text scene file.
+static bool loadScene(Scene & scene, void (*write)(FILE * file, float mass), float mass) {
+  char path[] = "/tmp/testsceneXXXXXX";
+  int fd = mkstemp(path);
+  if (fd == -1) {
+    perror("mkstemp");
+    return false;
+  }
+  FILE * file = fdopen(fd, "w");
+  write(file, mass);
+  fclose(file);
+  bool loaded = scene.load(path);
+  unlink(path);
+  return loaded;
+}
+
+// A lattice of boxes moving every which way, the same on every run, so
+// that there are collisions all through it.
+static void writeLattice(FILE * file, float mass) {
+  fprintf(file, "shapes 2\ncuboid 1 1 1\ncuboid 0.5 1.5 1\nobjects %d\n", GRID * GRID * GRID);
+  unsigned int seed = 12345;
+  for (int i = 0; i < GRID * GRID * GRID; i++) {
+    float values[7];
+    for (int k = 0; k < 7; k++) {
+      seed = seed * 1103515245u + 12345u;
+      values[k] = ((seed >> 8) & 0xffff) / 32768.0f - 1.0f;
+    }
+    fprintf(file, "%d %g %g %g %g 1 0 0 0 %g %g %g %g %g %g %g\n", i % 2, mass,
+            SPACING * (i % GRID), SPACING * (i / GRID % GRID), SPACING * (i / GRID / GRID),
+            values[0], values[1], values[2] + 2.0f, values[3], values[4], values[5],
+            values[6]);
+  }
+}
+
+// two spinning cubes meeting head on at about t = 1.5
+static void writeHeadOn(FILE * file, float mass) {
+  fprintf(file, "shapes 1\ncuboid 1 1 1\nobjects 2\n");
+  fprintf(file, "0 %g -2 0 0 1 0 0 0 0 0 1 1 0 0 0.5\n", mass);
+  fprintf(file, "0 %g 2 0.2 0 1 0 0 0 0 1 0 -1 0 0 -0.5\n", mass);
+}
+
+// After a warm up, the engine should not allocate per event any more.
+static void checkAllocations(Scene const & scene, BroadPhaseType type, char const * name) {
+  MotionEngine motionengine;
+  DummyEngine dummyengine(motionengine, scene.objects(), scene.events());
+  dummyengine.setBroadPhase(type);
+  dummyengine.processEvents(WARMUP_TIME, INT_MAX);
+
+  Stats before, after;
+  Profiler::shared().stats(before);
+  int events = dummyengine.processEvents(WARMUP_TIME + RUN_TIME, INT_MAX);
+  Profiler::shared().stats(after);
+
+  long long allocations = after.counters[COUNTER_ALLOCATIONS] - before.counters[COUNTER_ALLOCATIONS];
+  long long bound = events / EVENTS_PER_ALLOCATION + ALLOCATION_SLACK;
+  char detail[128];
+  snprintf(detail, sizeof(detail), "%lld allocations for %d events, at most %lld",
+           allocations, events, bound);
+  check(events > 0 && allocations <= bound, name, detail);
+}
+
+// Slabs simulated by processes of their own should end up where a single
+// engine does. The lattice is cut right through, so plenty of collisions
+// happen across a boundary.
+static void checkRegions(Scene const & scene, int num_regions, float window, char const * name) {
+  MotionEngine motionengine;
+  DummyEngine dummyengine(motionengine, scene.objects(), scene.events());
+  vector<glm::mat4> expected;
+  dummyengine.getPoses(REGIONS_TIME, expected);
+
+  vector<CollisionEvent> events;
+  bool ran = Region::simulate(scene, num_regions, AABB_TREE, REGIONS_TIME, window, events);
+  float worst = 0.0f;
+  int off = 0;
+  for (int i = 0; i < events.size(); i++) {
+    glm::mat4 pose;
+    motionengine.pose(events[i], REGIONS_TIME, pose);
+    float distance = glm::length(glm::vec3(pose[3]) - glm::vec3(expected[i][3]));
+    worst = max(worst, distance);
+    if (distance > REGIONS_TOLERANCE) {
+      off++;
+    }
+  }
+  char detail[128];
+  snprintf(detail, sizeof(detail), "%d of %d objects off by more than %g, at most %g",
+           off, (int)events.size(), REGIONS_TOLERANCE, worst);
+  check(ran && off == 0, name, detail);
+}
+
+// Scaling both masses scales the impulse with them, so a collision of
+// light objects should come out the same as one of heavier ones.
+static void checkFractionalMass() {
+  Scene light, heavy;
+  if (!loadScene(light, writeHeadOn, 0.5f) || !loadScene(heavy, writeHeadOn, 1.0f)) {
+    check(false, "fractional mass", "scene did not load");
+    return;
+  }
+  MotionEngine motionengine;
+  DummyEngine light_engine(motionengine, light.objects(), light.events());
+  DummyEngine heavy_engine(motionengine, heavy.objects(), heavy.events());
+  vector<glm::mat4> light_poses, heavy_poses;
+  light_engine.getPoses(MASS_TIME, light_poses);
+  heavy_engine.getPoses(MASS_TIME, heavy_poses);
+
+  float worst = 0.0f;
+  bool finite = true;
+  for (int i = 0; i < 2; i++) {
+    glm::vec3 position = glm::vec3(light_poses[i][3]);
+    finite = finite && isfinite(position.x) && isfinite(position.y) && isfinite(position.z);
+    worst = max(worst, glm::length(position - glm::vec3(heavy_poses[i][3])));
+  }
+  // the first cube would be at x = 1 had it flown on
+  float x = light_poses[0][3].x;
+  char detail[128];
+  snprintf(detail, sizeof(detail), "first cube at x = %g, %g from the mass 1 run", x, worst);
+  check(finite && x < -1.0f && worst <= MASS_TOLERANCE, "fractional mass", detail);
+}
+
+int main() {
+  Scene scene;
+  if (!loadScene(scene, writeLattice, 1.0f)) {
+    return 1;
+  }
+
+  checkAllocations(scene, AABB_TREE, "allocations, aabb tree");
+  checkAllocations(scene, SWEEP_AND_PRUNE, "allocations, sweep and prune");
+  checkAllocations(scene, SPATIAL_HASH, "allocations, grid");
+  checkRegions(scene, 3, 1.0f, "3 regions, window 1");
+  checkRegions(scene, 3, 0.1f, "3 regions, window 0.1");
+  checkRegions(scene, 3, 0.01f, "3 regions, window 0.01");
+  checkRegions(scene, 5, 0.1f, "5 regions, window 0.1");
+  checkFractionalMass();
+
+  return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,125 @@
+#include "threadpool.h"
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+ThreadPool::ThreadPool(int num_threads) {
+  task_ = NULL;
+  batch_ = 0;
+  finished_ = 0;
+  stop_ = false;
+
+  if (num_threads < 1) {
+    num_threads = 1;
+  }
+  for (int i = 0; i < num_threads; i++) {
+    workers_.push_back(unique_ptr<Worker>(new Worker()));
+    workers_.back()->front = 0;
+  }
+  for (int i = 1; i < num_threads; i++) {
+    threads_.push_back(thread(&ThreadPool::loop, this, i));
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    lock_guard<mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (int i = 0; i < threads_.size(); i++) {
+    threads_[i].join();
+  }
+}
+
+int ThreadPool::size() const {
+  return workers_.size();
+}
+
+void ThreadPool::run(int num_tasks, function<void(int, int)> const & task) {
+  if (num_tasks <= 0) {
+    return;
+  }
+
+  {
+    // every thread is waiting for the next batch, so nothing else is
+    // looking at the task lists
+    lock_guard<mutex> lock(mutex_);
+    task_ = &task;
+    for (int i = 0; i < workers_.size(); i++) {
+      workers_[i]->tasks.clear();
+      workers_[i]->front = 0;
+    }
+    for (int i = 0; i < num_tasks; i++) {
+      workers_[i % workers_.size()]->tasks.push_back(i);
+    }
+    finished_ = 0;
+    batch_++;
+  }
+  wake_.notify_all();
+
+  work(0);
+
+  // Wait for every thread rather than every task, so none of them is
+  // still looking at this batch once the next one starts.
+  unique_lock<mutex> lock(mutex_);
+  done_.wait(lock, [this] { return finished_ == (int)threads_.size(); });
+  task_ = NULL;
+}
+
+void ThreadPool::loop(int worker) {
+  long long seen = 0;
+  while (true) {
+    {
+      unique_lock<mutex> lock(mutex_);
+      wake_.wait(lock, [this, seen] { return stop_ || batch_ != seen; });
+      if (stop_) {
+        return;
+      }
+      seen = batch_;
+    }
+
+    work(worker);
+
+    {
+      lock_guard<mutex> lock(mutex_);
+      finished_++;
+    }
+    done_.notify_one();
+  }
+}
+
+void ThreadPool::work(int worker) {
+  int task;
+  while (next(worker, task)) {
+    (*task_)(task, worker);
+  }
+}
+
+// Newest task of our own, otherwise the oldest one of someone else.
+bool ThreadPool::next(int worker, int & task) {
+  {
+    Worker & own = *workers_[worker];
+    lock_guard<mutex> lock(own.mutex);
+    if (own.front < own.tasks.size()) {
+      task = own.tasks.back();
+      own.tasks.pop_back();
+      return true;
+    }
+  }
+
+  for (int i = 1; i < workers_.size(); i++) {
+    Worker & victim = *workers_[(worker + i) % workers_.size()];
+    lock_guard<mutex> lock(victim.mutex);
+    if (victim.front < victim.tasks.size()) {
+      task = victim.tasks[victim.front++];
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,51 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads for running batches of independent tasks. Every
+// worker has its own list of tasks and takes from the back of it, and once
+// it runs dry steals from the front of the others'. The thread calling run
+// works as worker 0 until the whole batch is done.
+class ThreadPool {
+  public:
+    ThreadPool(int num_threads);
+    ~ThreadPool();
+
+    int size() const;  // workers, counting the caller
+
+    // Calls task(i, worker) for every i in [0, num_tasks) and returns once
+    // they have all finished. worker is in [0, size()) and no two tasks run
+    // on the same worker at once, so it can index per worker scratch space.
+    void run(int num_tasks, std::function<void(int, int)> const & task);
+
+  private:
+    struct Worker {
+      std::mutex mutex;
+      // tasks[front..] are left, kept in a vector so that its room is
+      // reused by the next batch
+      std::vector<int> tasks;
+      int front;
+    };
+
+    void loop(int worker);
+    void work(int worker);
+    bool next(int worker, int & task);
+
+    std::vector<std::unique_ptr<Worker> > workers_;
+    std::vector<std::thread> threads_;
+    std::function<void(int, int)> const * task_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    long long batch_;
+    int finished_;  // threads done with the current batch
+    bool stop_;
+};
+
+#endif
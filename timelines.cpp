@@ -0,0 +1,93 @@
+#include "timelines.h"
+#include <algorithm>
+#include <new>
+#include <vector>
+#include "collisionevent.h"
+#include "pool.h"
+
+#define CHUNK_SIZES 7  // 1, 2, 4 up to 64 events
+
+using namespace std;
+
+Timelines::Timelines() {
+  static_assert(sizeof(Chunk) % alignof(CollisionEvent) == 0, "events right after the chunk");
+  for (int size = 0; size < CHUNK_SIZES; size++) {
+    pools_.push_back(Pool(sizeof(Chunk) + (sizeof(CollisionEvent) << size)));
+  }
+}
+
+void Timelines::resize(int num_objects) {
+  latest_.resize(num_objects, NULL);
+}
+
+void Timelines::append(CollisionEvent const & event) {
+  Chunk * & chunk = latest_[event.object()];
+  if (chunk == NULL) {
+    chunk = newChunk(0, NULL);
+  } else if (chunk->count == (1 << chunk->size)) {
+    chunk = newChunk(min(chunk->size + 1, CHUNK_SIZES - 1), chunk);
+  }
+  new (events(chunk) + chunk->count) CollisionEvent(event);
+  chunk->count++;
+}
+
+void Timelines::reset(CollisionEvent const & event) {
+  Chunk * & chunk = latest_[event.object()];
+  while (chunk != NULL) {
+    Chunk * previous = chunk->previous;
+    pools_[chunk->size].release(chunk);
+    chunk = previous;
+  }
+  append(event);
+}
+
+CollisionEvent const & Timelines::latest(int object_id) const {
+  Chunk const * chunk = latest_[object_id];
+  return events(chunk)[chunk->count - 1];
+}
+
+// Almost always the latest event, otherwise the chunks are walked back to
+// the one the time falls in, which is searched.
+CollisionEvent const & Timelines::at(int object_id, float time) const {
+  Chunk const * chunk = latest_[object_id];
+  CollisionEvent const * chunk_events = events(chunk);
+  if (chunk_events[chunk->count - 1].time() < time) {
+    return chunk_events[chunk->count - 1];
+  }
+  while (chunk->previous != NULL && !(events(chunk)[0].time() < time)) {
+    chunk = chunk->previous;
+  }
+  chunk_events = events(chunk);
+
+  int low = 0;
+  int high = chunk->count - 1;
+  while (low < high) {
+    int middle = (low + high) / 2;
+    if (chunk_events[middle].time() < time) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  // low is the first event at or after time, unless all of them are before
+  if (chunk_events[low].time() < time) {
+    return chunk_events[low];
+  }
+  return chunk_events[max(low - 1, 0)];
+}
+
+CollisionEvent * Timelines::events(Chunk * chunk) {
+  return (CollisionEvent *)(chunk + 1);
+}
+
+CollisionEvent const * Timelines::events(Chunk const * chunk) {
+  return (CollisionEvent const *)(chunk + 1);
+}
+
+Timelines::Chunk * Timelines::newChunk(int size, Chunk * previous) {
+  Chunk * chunk = (Chunk *)pools_[size].allocate();
+  chunk->previous = previous;
+  chunk->count = 0;
+  chunk->size = size;
+  return chunk;
+}
@@ -0,0 +1,41 @@
+#ifndef TIMELINES_H
+#define TIMELINES_H
+#include <vector>
+#include "collisionevent.h"
+#include "pool.h"
+
+// Every event applied to each object, in order, starting with its initial
+// one. An object's events are kept in chunks linked from the latest one
+// back, each twice the size of the one before up to a limit and taken from
+// a pool per size, so appending never moves events and only goes to the
+// heap when a pool needs another slab.
+class Timelines {
+  public:
+    Timelines();
+
+    void resize(int num_objects);
+    // to the timeline of the event's object
+    void append(CollisionEvent const & event);
+    // leaves event as the only one of its object
+    void reset(CollisionEvent const & event);
+
+    CollisionEvent const & latest(int object_id) const;
+    // the latest event before time, or the first one if there is none
+    CollisionEvent const & at(int object_id, float time) const;
+
+  private:
+    struct Chunk {
+      Chunk * previous;
+      int count;
+      int size;  // index into pools_, the chunk holds 1 << size events
+    };
+
+    static CollisionEvent * events(Chunk * chunk);
+    static CollisionEvent const * events(Chunk const * chunk);
+    Chunk * newChunk(int size, Chunk * previous);
+
+    std::vector<Chunk *> latest_;
+    std::vector<Pool> pools_;
+};
+
+#endif
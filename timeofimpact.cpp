@@ -0,0 +1,83 @@
+#include "timeofimpact.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+#include "collisionevent.h"
+#include "contact.h"
+#include "convexcollision.h"
+#include "motionengine.h"
+#include "supportmapping.h"
+#define MAX_ITERATIONS 100
+#define TOI_TOLERANCE 1e-3f  // distance at which the objects count as touching
+
+TimeOfImpact::TimeOfImpact() { }
+
+TimeOfImpact::TimeOfImpact(MotionEngine & motionengine) {
+  motionengine_ = &motionengine;
+}
+
+ImpactResult TimeOfImpact::solve(SupportMapping const & a,
+                                 float radius_a,
+                                 CollisionEvent const & motion_a,
+                                 SupportMapping const & b,
+                                 float radius_b,
+                                 CollisionEvent const & motion_b,
+                                 float start,
+                                 float end,
+                                 float & time,
+                                 Contact & contact) const {
+  // rotation can move a surface point at most this fast
+  float spin = std::fabs(motion_a.angular_velocity()) * radius_a +
+               std::fabs(motion_b.angular_velocity()) * radius_b;
+  glm::vec3 relative_velocity = *motion_a.velocity() - *motion_b.velocity();
+
+  float t = start;
+  for (int iteration = 0; iteration < MAX_ITERATIONS && t <= end; iteration++) {
+    glm::mat4 pose_a, pose_b;
+    motionengine_->pose(motion_a, t, pose_a);
+    motionengine_->pose(motion_b, t, pose_b);
+
+    glm::vec3 point_a, point_b;
+    float distance = convexcollision_.distance(a, pose_a, b, pose_b, point_a, point_b);
+
+    contact.clearPoints();
+    if (distance <= 0.0f) {
+      convexcollision_.intersect(a, pose_a, b, pose_b, contact);
+    } else {
+      contact.setNormal((point_a - point_b) / distance);
+      contact.setDepth(-distance);
+      contact.addPoint((point_a + point_b) * 0.5f);
+    }
+
+    // touching objects that are already moving apart were just resolved
+    if (distance < TOI_TOLERANCE && approaching(motion_a, motion_b, t, contact)) {
+      time = t;
+      return IMPACT_FOUND;
+    }
+
+    float closing = std::max(-glm::dot(relative_velocity, contact.normal()), 0.0f) + spin;
+    if (closing <= 0.0f) {
+      return IMPACT_NONE;
+    }
+    // Aim for half the tolerance rather than touching. Exactly touching
+    // objects have no well defined normal, so the pair would look like it
+    // is still approaching right after the collision is resolved.
+    t += std::max(distance - 0.5f * TOI_TOLERANCE, 0.5f * TOI_TOLERANCE) / closing;
+  }
+  if (t > end) {
+    return IMPACT_NONE;
+  }
+  // only known to be apart up to here, so the caller has to look again from it
+  time = t;
+  return IMPACT_UNRESOLVED;
+}
+
+bool TimeOfImpact::approaching(CollisionEvent const & motion_a,
+                               CollisionEvent const & motion_b,
+                               float time,
+                               Contact const & contact) const {
+  glm::vec3 velocity_a, velocity_b;
+  motionengine_->velocityAt(motion_a, time, contact.center(), velocity_a);
+  motionengine_->velocityAt(motion_b, time, contact.center(), velocity_b);
+  return glm::dot(velocity_a - velocity_b, contact.normal()) < 0.0f;
+}
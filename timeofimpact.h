@@ -0,0 +1,47 @@
+#ifndef TIMEOFIMPACT_H
+#define TIMEOFIMPACT_H
+#include "collisionevent.h"
+#include "contact.h"
+#include "convexcollision.h"
+#include "motionengine.h"
+#include "supportmapping.h"
+
+enum ImpactResult {
+  IMPACT_NONE,       // no contact up to end
+  IMPACT_FOUND,      // first contact at time
+  IMPACT_UNRESOLVED  // ran out of iterations, no contact up to time
+};
+
+// First time two objects touch while following the motion in their latest
+// CollisionEvent, found by conservative advancement: step forward by the
+// current distance over the fastest the two could be closing in on each
+// other, which can never step past the contact.
+class TimeOfImpact {
+  public:
+    TimeOfImpact();
+    TimeOfImpact(MotionEngine & motionengine);
+
+    // radius is the distance from the center to the furthest vertex. The
+    // contact normal points from b towards a.
+    ImpactResult solve(SupportMapping const & a,
+                       float radius_a,
+                       CollisionEvent const & motion_a,
+                       SupportMapping const & b,
+                       float radius_b,
+                       CollisionEvent const & motion_b,
+                       float start,
+                       float end,
+                       float & time,
+                       Contact & contact) const;
+
+  private:
+    bool approaching(CollisionEvent const & motion_a,
+                     CollisionEvent const & motion_b,
+                     float time,
+                     Contact const & contact) const;
+
+    MotionEngine * motionengine_;
+    ConvexCollision convexcollision_;
+};
+
+#endif
@@ -0,0 +1,43 @@
+#include "unionfind.h"
+#include <vector>
+
+UnionFind::UnionFind() { }
+
+void UnionFind::resize(int num_objects) {
+  int old_size = parents_.size();
+  parents_.resize(num_objects);
+  sizes_.resize(num_objects, 1);
+  for (int i = old_size; i < num_objects; i++) {
+    parents_[i] = i;
+  }
+}
+
+int UnionFind::find(int object_id) {
+  int i = object_id;
+  while (parents_[i] != i) {
+    // path halving
+    parents_[i] = parents_[parents_[i]];
+    i = parents_[i];
+  }
+  return i;
+}
+
+void UnionFind::join(int object_a, int object_b) {
+  int a = find(object_a);
+  int b = find(object_b);
+  if (a == b) {
+    return;
+  }
+  if (sizes_[a] < sizes_[b]) {
+    int swap = a;
+    a = b;
+    b = swap;
+  }
+  parents_[b] = a;
+  sizes_[a] += sizes_[b];
+}
+
+void UnionFind::reset(int object_id) {
+  parents_[object_id] = object_id;
+  sizes_[object_id] = 1;
+}
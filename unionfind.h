@@ -0,0 +1,23 @@
+#ifndef UNIONFIND_H
+#define UNIONFIND_H
+#include <vector>
+
+// Disjoint sets over object ids, for grouping objects that touch each
+// other into islands. Only the sets that were joined need resetting, so
+// it stays cheap when few objects are involved at a time.
+class UnionFind {
+  public:
+    UnionFind();
+
+    void resize(int num_objects);
+    int find(int object_id);
+    void join(int object_a, int object_b);
+    // back to a set of its own
+    void reset(int object_id);
+
+  private:
+    std::vector<int> parents_;
+    std::vector<int> sizes_;
+};
+
+#endif
@@ -9,61 +9,47 @@
 #include <glm/glm.hpp>
 #include "object.h"
 #include "viewer.h"
-#include "state.h"
-#include "dummyengine.h"
+#include "profiler.h"
+#include "scenerenderer.h"
+#include "simulationthread.h"
+#include "snapshotbuffer.h"
 
-DummyEngine * Viewer::dummyengine_;
-float Viewer::time_;
+#define SCRUB_STEP 1.0f
+
+std::vector<Object*> const * Viewer::objects_;
+SnapshotBuffer * Viewer::snapshots_;
+SimulationThread * Viewer::simulationthread_;
+float Viewer::until_;
+bool Viewer::scrubbed_;
+SceneRenderer Viewer::scene_;
 
 Viewer::Viewer() {}
 
-Viewer::Viewer(DummyEngine & dummyengine) {
-  dummyengine_ = &dummyengine;
-  time_ = 0.0;
+Viewer::Viewer(std::vector<Object*> const & objects,
+               SnapshotBuffer & snapshots,
+               SimulationThread & simulationthread,
+               float until) {
+  objects_ = &objects;
+  snapshots_ = &snapshots;
+  simulationthread_ = &simulationthread;
+  until_ = until;
+  scrubbed_ = false;
 }
 
-void Viewer::populateGlBuffers(float time) {
-  State state = State();
-  glm::mat4 * pose;
-  int numobjects_ = dummyengine_->numObjects();
-  for (int i = 0; i < numobjects_; i++) {
-    dummyengine_->getState(i, time, state);
-    pose = state.pose();
-
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glEnableClientState(GL_COLOR_ARRAY);
-
-    glVertexPointer(4, GL_FLOAT, 0, state.verts());
-    glColorPointer(4, GL_FLOAT, 0, state.verts());
-
-    glPushMatrix();
-    glMultMatrixf((float*)state.pose());
-    glDrawElements(GL_TRIANGLES, 3 * 12, GL_UNSIGNED_INT, state.tris());
-    glPopMatrix();
-
-    glDisableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_COLOR_ARRAY);
+void Viewer::populateGlBuffers() {
+  PROFILE_SCOPE(PHASE_RENDER);
+  snapshots_->acquire();
+  if (snapshots_->empty()) {
+    scene_.draw(std::vector<glm::mat4>());
+    return;
   }
+  scene_.draw(snapshots_->front().poses);
 }
 
 void Viewer::display() {
-  glClearColor(255.0,255.0,255.0,1.0);
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-  glLoadIdentity(); // Reset transformations
-
-  // default camera position
-  glTranslatef(0., 0., -10.);
-
-  // default to showing the borders of triangles
-  glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-  //glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-  glEnable(GL_DEPTH_TEST); //enable the depth testing
-  
-  populateGlBuffers(time_);
-  time_ += 0.01;
-  
-  if (time_ > 100.0) {
+  populateGlBuffers();
+
+  if (!scrubbed_ && !snapshots_->empty() && snapshots_->front().time >= until_) {
     exit(0);
   }
 
@@ -72,13 +58,29 @@ void Viewer::display() {
 }
 
 void Viewer::reshape(int w, int h) {
-  glViewport (0, 0, (GLsizei) w, (GLsizei) h);
-  glMatrixMode(GL_PROJECTION);
-  glLoadIdentity();
-  gluPerspective(30.0, (GLfloat) w/(GLfloat) h, 0.1, 200.0);
-  glMatrixMode(GL_MODELVIEW);
+  scene_.reshape(w, h);
+}
+
+// Escape or q quits.
+void Viewer::keyboard(unsigned char key, int x, int y) {
+  if (key == 27 || key == 'q') {
+    exit(0);
+  }
+}
 
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+// Left and right jump a second back or ahead, home goes back to the start.
+void Viewer::special(int key, int x, int y) {
+  float time = snapshots_->empty() ? 0.0f : snapshots_->front().time;
+  if (key == GLUT_KEY_LEFT) {
+    simulationthread_->seek(time - SCRUB_STEP);
+  } else if (key == GLUT_KEY_RIGHT) {
+    simulationthread_->seek(time + SCRUB_STEP);
+  } else if (key == GLUT_KEY_HOME) {
+    simulationthread_->seek(0.0f);
+  } else {
+    return;
+  }
+  scrubbed_ = true;
 }
 
 void Viewer::initGlut(int argc, char * argv[]) {
@@ -92,15 +94,14 @@ void Viewer::initGlut(int argc, char * argv[]) {
   glutInitWindowSize(1000,800);
   glutCreateWindow("Collision Detection Demo");
 
-  //  Enable Z-buffer depth test
-  glClearDepth(1.0f);
-  glDepthFunc(GL_LEQUAL);
-  glEnable(GL_DEPTH_TEST);
+  scene_.init(*objects_);
 
   // Callback functions
   glutDisplayFunc(display);
   glutIdleFunc(display);
   glutReshapeFunc(reshape);
+  glutKeyboardFunc(keyboard);
+  glutSpecialFunc(special);
 
   //  Pass control to GLUT for events
   glutMainLoop();
@@ -1,20 +1,34 @@
 #ifndef VIEWER_H
 #define VIEWER_H
-#include "dummyengine.h"
+#include <vector>
+#include "object.h"
+#include "scenerenderer.h"
+#include "simulationthread.h"
+#include "snapshotbuffer.h"
 
 class Viewer {
   public:
     Viewer();
-    Viewer(DummyEngine & dummyengine);
+    Viewer(std::vector<Object*> const & objects,
+           SnapshotBuffer & snapshots,
+           SimulationThread & simulationthread,
+           float until);
     static void initGlut(int argc, char * argv[]);
 
   private:
-    static void populateGlBuffers(float time);
+    static void populateGlBuffers();
     static void display();
     static void reshape(int w, int h);
+    static void keyboard(unsigned char key, int x, int y);
+    static void special(int key, int x, int y);
 
-    static DummyEngine * dummyengine_;
-    static float time_;
+    // drawn from the latest snapshot the simulation thread published
+    static std::vector<Object*> const * objects_;
+    static SnapshotBuffer * snapshots_;
+    static SimulationThread * simulationthread_;  // for scrubbing
+    static float until_;
+    static bool scrubbed_;  // once scrubbed, reaching until pauses instead of quitting
+    static SceneRenderer scene_;
 };
 
 #endif